@@ -0,0 +1,117 @@
+#include "adaptive_sort.h"
+#include "counting_sort.h"
+#include "merge_sort_variants.h"
+#include "quick_sort_variants.h"
+#include "sort_configs.h"
+#include <algorithm>
+#include <atomic>
+
+namespace adaptive {
+    const int kNetworkMaxSize = 8;
+    const int kProfileMinSize = 256;
+    const int kMinAverageRunLength = 64;
+    const int kSampleSize = 64;
+    const double kHeavyDuplicateRatio = 0.5;
+
+    static std::atomic<SortDecisionHook> decisionHook{nullptr};
+
+    // Same run boundaries as the natural merge sort; stops after maxRuns + 1.
+    static int countRuns(const int* arr, int size, int maxRuns) {
+        int runs = 0;
+        int start = 0;
+        while (start < size && runs <= maxRuns) {
+            int end = start + 1;
+            if (end < size && arr[end] < arr[start]) {
+                while (end < size && arr[end] < arr[end - 1]) end++;
+            } else {
+                while (end < size && arr[end] >= arr[end - 1]) end++;
+            }
+            runs++;
+            start = end;
+        }
+        return runs;
+    }
+
+    static void sortNetwork(int* arr, int size) {
+        if (size == 2) {
+            if (arr[1] < arr[0]) std::swap(arr[0], arr[1]);
+            return;
+        }
+        configs::Current3To8Config::applySortingNetwork(arr, size);
+    }
+}
+
+SortProfile profileSort(const int* arr, int size) {
+    using namespace adaptive;
+    SortProfile profile;
+    profile.size = size;
+    if (size <= kNetworkMaxSize) {
+        profile.engine = SortEngine::Network;
+        return profile;
+    }
+    if (size < kProfileMinSize) {
+        profile.engine = SortEngine::QuickSort;
+        return profile;
+    }
+
+    int maxRuns = size / kMinAverageRunLength;
+    profile.runs = countRuns(arr, size, maxRuns);
+    if (profile.runs <= maxRuns) {
+        profile.engine = SortEngine::NaturalMerge;
+        return profile;
+    }
+
+    int sample[kSampleSize];
+    for (int k = 0; k < kSampleSize; k++) {
+        sample[k] = arr[static_cast<int64_t>(size - 1) * k / (kSampleSize - 1)];
+    }
+    quickSort3To8(sample, kSampleSize);
+    int equalNeighbours = 0;
+    for (int k = 1; k < kSampleSize; k++) {
+        equalNeighbours += sample[k] == sample[k - 1];
+    }
+    profile.duplicateRatio = static_cast<double>(equalNeighbours) / (kSampleSize - 1);
+    profile.valueRange = int64_t(sample[kSampleSize - 1]) - sample[0] + 1;
+
+    // The sample range is a lower bound on the real one.
+    if (shouldUseCountingSort(size, sample[0], sample[kSampleSize - 1])) {
+        findRange(arr, size, &profile.minValue, &profile.maxValue);
+        profile.valueRange = int64_t(profile.maxValue) - profile.minValue + 1;
+        if (shouldUseCountingSort(size, profile.minValue, profile.maxValue)) {
+            profile.engine = SortEngine::CountingSort;
+            return profile;
+        }
+    }
+    profile.engine = profile.duplicateRatio >= kHeavyDuplicateRatio ? SortEngine::ThreeWayQuickSort
+                                                                    : SortEngine::QuickSort;
+    return profile;
+}
+
+void sort(int* arr, int size) {
+    SortProfile profile = profileSort(arr, size);
+    if (SortDecisionHook hook = adaptive::decisionHook.load(std::memory_order_acquire)) {
+        hook(profile);
+    }
+    switch (profile.engine) {
+        case SortEngine::Network: adaptive::sortNetwork(arr, size); return;
+        case SortEngine::NaturalMerge: mergeSortNatural3To8(arr, size); return;
+        case SortEngine::CountingSort: countingSort(arr, size, profile.minValue, profile.maxValue); return;
+        case SortEngine::ThreeWayQuickSort: quickSort3To8ThreeWay(arr, size); return;
+        case SortEngine::QuickSort: quickSort3To8(arr, size); return;
+    }
+}
+
+void setSortDecisionHook(SortDecisionHook hook) {
+    adaptive::decisionHook.store(hook, std::memory_order_release);
+}
+
+const char* sortEngineName(SortEngine engine) {
+    switch (engine) {
+        case SortEngine::Network: return "Network";
+        case SortEngine::QuickSort: return "QuickSort";
+        case SortEngine::NaturalMerge: return "NaturalMerge";
+        case SortEngine::CountingSort: return "CountingSort";
+        case SortEngine::ThreeWayQuickSort: return "ThreeWayQuickSort";
+    }
+    return "Unknown";
+}
@@ -0,0 +1,55 @@
+#ifndef ADAPTIVE_SORT_H_
+#define ADAPTIVE_SORT_H_
+
+#include <cstdint>
+
+// Single entry point that looks at the input before choosing an engine:
+//   - up to 8 elements: the AlphaDev networks;
+//   - fewer than 256: quickSort3To8, without profiling;
+//   - at most one run per 64 elements: mergeSortNatural3To8;
+//   - at most 8 possible values per element: countingSort;
+//   - half or more of a 64-element sample equal to a neighbour:
+//     quickSort3To8ThreeWay;
+//   - otherwise quickSort3To8.
+// Runs are counted with an early exit once there are too many, so random
+// input pays for a short prefix scan only. The value range is estimated from
+// the sample and confirmed with a full pass only when counting sort could
+// apply.
+
+enum class SortEngine {
+    Network,
+    QuickSort,
+    NaturalMerge,
+    CountingSort,
+    ThreeWayQuickSort
+};
+
+struct SortProfile {
+    int size = 0;
+    // Maximal ascending or strictly descending runs, counted up to one more
+    // than the natural merge limit.
+    int runs = 0;
+    // Fraction of neighbouring elements of the sorted sample that are equal.
+    double duplicateRatio = 0;
+    // max - min + 1: of the whole array when counting sort was considered,
+    // of the sample otherwise.
+    int64_t valueRange = 0;
+    // The array's extremes, set only when counting sort was considered.
+    int minValue = 0;
+    int maxValue = 0;
+    SortEngine engine = SortEngine::QuickSort;
+};
+
+// The decision sort() would make, without modifying the array.
+SortProfile profileSort(const int* arr, int size);
+
+void sort(int* arr, int size);
+
+// Called by sort() with each profile before dispatching; nullptr (the
+// default) disables it. The hook may run concurrently from several threads.
+using SortDecisionHook = void (*)(const SortProfile& profile);
+void setSortDecisionHook(SortDecisionHook hook);
+
+const char* sortEngineName(SortEngine engine);
+
+#endif
@@ -0,0 +1,141 @@
+#include "async_sort.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+enum class JobState {
+    Queued,
+    Running,
+    Finished
+};
+
+struct SortJob {
+    SortThreadPool::SortFunction sortFunc;
+    int* arr;
+    int size;
+    SortThreadPool::Callback onComplete;
+    std::promise<SortStatus> promise;
+    std::atomic<JobState> state{JobState::Queued};
+
+    // Claims a queued job for whoever moves it out of Queued first: a worker
+    // starting it or a caller cancelling it.
+    bool claim(JobState next) {
+        JobState expected = JobState::Queued;
+        return state.compare_exchange_strong(expected, next);
+    }
+
+    void finish(SortStatus status, std::exception_ptr error = nullptr) {
+        try {
+            if (onComplete) onComplete(status);
+        } catch (...) {
+            if (!error) error = std::current_exception();
+        }
+        if (error) {
+            promise.set_exception(error);
+        } else {
+            promise.set_value(status);
+        }
+    }
+};
+
+SortStatus SortHandle::wait() const {
+    if (!future_.valid()) return SortStatus::Cancelled;
+    return future_.get();
+}
+
+bool SortHandle::cancel() {
+    if (!job_ || !job_->claim(JobState::Finished)) return false;
+    job_->finish(SortStatus::Cancelled);
+    return true;
+}
+
+SortThreadPool::SortThreadPool(int threads) {
+    threads = std::max(threads, 1);
+    concurrencyLimit_ = threads;
+    for (int i = 0; i < threads; i++) {
+        workers_.emplace_back(&SortThreadPool::workerLoop, this);
+    }
+}
+
+SortThreadPool::~SortThreadPool() {
+    std::deque<std::shared_ptr<SortJob>> pending;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        pending.swap(queue_);
+    }
+    wakeUp_.notify_all();
+    for (const std::shared_ptr<SortJob>& job : pending) {
+        if (job->claim(JobState::Finished)) job->finish(SortStatus::Cancelled);
+    }
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+SortHandle SortThreadPool::submit(SortFunction sortFunc, int* arr, int size, Callback onComplete) {
+    auto job = std::make_shared<SortJob>();
+    job->sortFunc = sortFunc;
+    job->arr = arr;
+    job->size = size;
+    job->onComplete = std::move(onComplete);
+    std::shared_future<SortStatus> future = job->promise.get_future().share();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(job);
+    }
+    wakeUp_.notify_one();
+    return SortHandle(std::move(job), std::move(future));
+}
+
+void SortThreadPool::setConcurrencyLimit(int limit) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        concurrencyLimit_ = std::clamp(limit, 1, threadCount());
+    }
+    wakeUp_.notify_all();
+}
+
+void SortThreadPool::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wakeUp_.wait(lock, [this] {
+            return stopping_ || (!queue_.empty() && running_ < concurrencyLimit_);
+        });
+        if (stopping_) return;
+
+        std::shared_ptr<SortJob> job = std::move(queue_.front());
+        queue_.pop_front();
+        // Cancelled jobs are dropped from the queue lazily.
+        if (!job->claim(JobState::Running)) continue;
+
+        running_++;
+        lock.unlock();
+        std::exception_ptr error;
+        try {
+            job->sortFunc(job->arr, job->size);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        job->state = JobState::Finished;
+        job->finish(error ? SortStatus::Failed : SortStatus::Completed, error);
+        lock.lock();
+        running_--;
+        // A slot opened up under the concurrency limit.
+        wakeUp_.notify_one();
+    }
+}
+
+SortThreadPool& SortThreadPool::shared() {
+    static SortThreadPool pool;
+    return pool;
+}
+
+int SortThreadPool::defaultThreadCount() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+SortHandle sortAsync(SortThreadPool::SortFunction sortFunc, int* arr, int size,
+                     SortThreadPool::Callback onComplete) {
+    return SortThreadPool::shared().submit(sortFunc, arr, size, std::move(onComplete));
+}
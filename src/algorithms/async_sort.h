@@ -0,0 +1,103 @@
+#ifndef ASYNC_SORT_H_
+#define ASYNC_SORT_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Asynchronous front end for the synchronous sort functions: jobs run on a
+// reusable pool of worker threads so a caller can decode or read the next
+// buffer while the previous one sorts. The buffer must stay alive and
+// untouched until the job completes or is cancelled.
+
+enum class SortStatus {
+    Completed,
+    Cancelled,
+    // The sort function threw. Only callbacks see this status; the job's
+    // future rethrows the exception instead.
+    Failed
+};
+
+struct SortJob;
+
+class SortHandle {
+public:
+    SortHandle() = default;
+
+    // Blocks until the job has completed or been cancelled. Rethrows an
+    // exception thrown by the sort function. An empty (default-constructed)
+    // handle has no job and returns Cancelled at once.
+    SortStatus wait() const;
+
+    // Cancels the job if it has not started yet; returns whether it did.
+    // A job that is already running always completes.
+    bool cancel();
+
+    std::shared_future<SortStatus> future() const {
+        return future_;
+    }
+
+private:
+    friend class SortThreadPool;
+
+    SortHandle(std::shared_ptr<SortJob> job, std::shared_future<SortStatus> future)
+        : job_(std::move(job)), future_(std::move(future)) {}
+
+    std::shared_ptr<SortJob> job_;
+    std::shared_future<SortStatus> future_;
+};
+
+class SortThreadPool {
+public:
+    using SortFunction = void (*)(int*, int);
+    // Runs exactly once per job, before the job's future becomes ready: on
+    // the worker after a sort (Completed or Failed), or on the cancelling
+    // thread. An exception it throws is delivered through the future.
+    using Callback = std::function<void(SortStatus)>;
+
+    explicit SortThreadPool(int threads = defaultThreadCount());
+
+    // Cancels every job still queued and waits for the running ones.
+    ~SortThreadPool();
+
+    SortThreadPool(const SortThreadPool&) = delete;
+    SortThreadPool& operator=(const SortThreadPool&) = delete;
+
+    SortHandle submit(SortFunction sortFunc, int* arr, int size, Callback onComplete = nullptr);
+
+    // At most `limit` jobs run at once (clamped to [1, threadCount()]), so
+    // sorting can leave cores free for the rest of a pipeline.
+    void setConcurrencyLimit(int limit);
+
+    int threadCount() const {
+        return static_cast<int>(workers_.size());
+    }
+
+    // Process-wide pool with defaultThreadCount() workers, created on first
+    // use.
+    static SortThreadPool& shared();
+
+    static int defaultThreadCount();
+
+private:
+    void workerLoop();
+
+    std::mutex mutex_;
+    std::condition_variable wakeUp_;
+    std::deque<std::shared_ptr<SortJob>> queue_;
+    std::vector<std::thread> workers_;
+    int running_ = 0;
+    int concurrencyLimit_;
+    bool stopping_ = false;
+};
+
+// Submits to SortThreadPool::shared().
+SortHandle sortAsync(SortThreadPool::SortFunction sortFunc, int* arr, int size,
+                     SortThreadPool::Callback onComplete = nullptr);
+
+#endif
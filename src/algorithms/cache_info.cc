@@ -0,0 +1,64 @@
+#include "cache_info.h"
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+namespace {
+    const size_t kDefaultL1d = 32 * 1024;
+    const size_t kDefaultL2 = 256 * 1024;
+    const size_t kDefaultL3 = 8 * 1024 * 1024;
+
+    size_t fromSysconf(int name) {
+        long value = sysconf(name);
+        return value > 0 ? static_cast<size_t>(value) : 0;
+    }
+
+    // Parses sizes such as "48K" or "300M" from sysfs.
+    size_t parseSize(const std::string& text) {
+        size_t pos = 0;
+        size_t value = 0;
+        while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9') {
+            value = value * 10 + (text[pos] - '0');
+            pos++;
+        }
+        if (pos < text.size() && text[pos] == 'K') value *= 1024;
+        if (pos < text.size() && text[pos] == 'M') value *= 1024 * 1024;
+        return value;
+    }
+
+    void fromSysfs(CacheSizes& sizes) {
+        for (int index = 0; index < 8; index++) {
+            std::string dir = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/";
+            std::ifstream levelFile(dir + "level"), typeFile(dir + "type"), sizeFile(dir + "size");
+            int level = 0;
+            std::string type, size;
+            if (!(levelFile >> level) || !(typeFile >> type) || !(sizeFile >> size)) break;
+            if (type == "Instruction") continue;
+
+            size_t bytes = parseSize(size);
+            if (level == 1 && sizes.l1d == 0) sizes.l1d = bytes;
+            if (level == 2 && sizes.l2 == 0) sizes.l2 = bytes;
+            if (level == 3 && sizes.l3 == 0) sizes.l3 = bytes;
+        }
+    }
+
+    CacheSizes detect() {
+        CacheSizes sizes = {0, 0, 0};
+#if defined(_SC_LEVEL1_DCACHE_SIZE) && defined(_SC_LEVEL2_CACHE_SIZE) && defined(_SC_LEVEL3_CACHE_SIZE)
+        sizes.l1d = fromSysconf(_SC_LEVEL1_DCACHE_SIZE);
+        sizes.l2 = fromSysconf(_SC_LEVEL2_CACHE_SIZE);
+        sizes.l3 = fromSysconf(_SC_LEVEL3_CACHE_SIZE);
+#endif
+        if (sizes.l1d == 0 || sizes.l2 == 0 || sizes.l3 == 0) fromSysfs(sizes);
+
+        if (sizes.l1d == 0) sizes.l1d = kDefaultL1d;
+        if (sizes.l2 == 0) sizes.l2 = kDefaultL2;
+        if (sizes.l3 == 0) sizes.l3 = kDefaultL3;
+        return sizes;
+    }
+}
+
+const CacheSizes& detectCacheSizes() {
+    static const CacheSizes sizes = detect();
+    return sizes;
+}
@@ -0,0 +1,16 @@
+#ifndef CACHE_INFO_H_
+#define CACHE_INFO_H_
+
+#include <cstddef>
+
+// Data cache sizes in bytes, detected once at first use from sysconf and
+// falling back to /sys/devices/system/cpu/cpu0/cache, then to typical values.
+struct CacheSizes {
+    size_t l1d;
+    size_t l2;
+    size_t l3;
+};
+
+const CacheSizes& detectCacheSizes();
+
+#endif
@@ -0,0 +1,97 @@
+#include "columnar_sort.h"
+#include "generic_sort.h"
+#include "prefetch.h"
+#include "quick_sort_variants.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace columnar {
+    const int kGatherBlock = 256;
+
+    struct PackedRow {
+        uint64_t key;
+        int row;
+    };
+
+    static uint64_t biased(int key) {
+        return static_cast<uint32_t>(key) ^ 0x80000000u;
+    }
+
+    // Keys are consumed two at a time: the pair is biased to unsigned and
+    // packed into one 64-bit word, so a single sort pass orders by both.
+    static uint64_t packKeys(const int* const* keyColumns, int keyIndex, int keyCount, int row) {
+        uint64_t high = biased(keyColumns[keyIndex][row]) << 32;
+        if (keyIndex + 1 == keyCount) return high;
+        return high | biased(keyColumns[keyIndex + 1][row]);
+    }
+
+    // Sorts entries[low, high), whose rows tie on every key before
+    // keyIndex, by the next one or two keys, then refines its own ties.
+    // Rows that tie on every key are put back in input order, which makes
+    // the result stable; the row indices are plain ints, so that last step
+    // runs on the AlphaDev network quick sort.
+    static void refine(PackedRow* entries, int low, int high, const int* const* keyColumns, int keyIndex,
+                       int keyCount, int* rowScratch) {
+        for (int i = low; i < high; i++) {
+            entries[i].key = packKeys(keyColumns, keyIndex, keyCount, entries[i].row);
+        }
+        generic::quickSort(entries + low, high - low, std::less<>(), &PackedRow::key);
+
+        int nextKey = keyIndex + 2;
+        for (int start = low; start < high;) {
+            int end = start + 1;
+            while (end < high && entries[end].key == entries[start].key) end++;
+            if (end - start > 1) {
+                if (nextKey < keyCount) {
+                    refine(entries, start, end, keyColumns, nextKey, keyCount, rowScratch);
+                } else {
+                    for (int i = start; i < end; i++) rowScratch[i - start] = entries[i].row;
+                    quickSort3To8(rowScratch, end - start);
+                    for (int i = start; i < end; i++) entries[i].row = rowScratch[i - start];
+                }
+            }
+            start = end;
+        }
+    }
+}
+
+std::vector<int> sortedRowOrder(const int* const* keyColumns, int keyCount, int rows) {
+    std::vector<int> order(rows);
+    for (int i = 0; i < rows; i++) order[i] = i;
+    if (keyCount <= 0) return order;
+
+    std::vector<columnar::PackedRow> entries(rows);
+    for (int i = 0; i < rows; i++) {
+        entries[i].row = i;
+    }
+    columnar::refine(entries.data(), 0, rows, keyColumns, 0, keyCount, order.data());
+    for (int i = 0; i < rows; i++) {
+        order[i] = entries[i].row;
+    }
+    return order;
+}
+
+void gatherColumn(int* column, const int* order, int rows, int* scratch) {
+    for (int start = 0; start < rows; start += columnar::kGatherBlock) {
+        int end = std::min(start + columnar::kGatherBlock, rows);
+        for (int i = start; i < end; i++) {
+            prefetchRead(column + order[i]);
+        }
+        for (int i = start; i < end; i++) {
+            scratch[i] = column[order[i]];
+        }
+    }
+    std::memcpy(column, scratch, rows * sizeof(int));
+}
+
+void sortTable(int* const* keyColumns, int keyCount, int* const* payloadColumns, int payloadCount, int rows) {
+    std::vector<int> order = sortedRowOrder(keyColumns, keyCount, rows);
+    std::vector<int> scratch(rows);
+    for (int c = 0; c < keyCount; c++) {
+        gatherColumn(keyColumns[c], order.data(), rows, scratch.data());
+    }
+    for (int c = 0; c < payloadCount; c++) {
+        gatherColumn(payloadColumns[c], order.data(), rows, scratch.data());
+    }
+}
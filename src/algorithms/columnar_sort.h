@@ -0,0 +1,24 @@
+#ifndef COLUMNAR_SORT_H_
+#define COLUMNAR_SORT_H_
+
+#include <vector>
+
+// ORDER BY over column-stored int tables, without building row structs.
+// Rows are ordered by keyColumns[0], ties by keyColumns[1], and so on, with
+// remaining ties kept in input order (stable).
+
+// Returns the sorted row order: entry i is the input row that goes to
+// position i. Keys are packed two per 64-bit word and sorted with the generic
+// network quick sort; only tie ranges are refined by the following keys.
+std::vector<int> sortedRowOrder(const int* const* keyColumns, int keyCount, int rows);
+
+// Reorders `column` to column[order[0]], column[order[1]], ... `scratch` must
+// hold `rows` ints. The gather runs in blocks: the source lines for a block
+// are prefetched before its values are copied.
+void gatherColumn(int* column, const int* order, int rows, int* scratch);
+
+// Sorts the table in place: computes the row order from the key columns and
+// gathers every key and payload column through it.
+void sortTable(int* const* keyColumns, int keyCount, int* const* payloadColumns, int payloadCount, int rows);
+
+#endif
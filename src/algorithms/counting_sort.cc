@@ -0,0 +1,144 @@
+#include "counting_sort.h"
+#include "cache_info.h"
+#include "quick_sort_variants.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace counting {
+    const int kMinSize = 256;
+    const int64_t kMaxValuesPerElement = 8;
+
+    // Offsets from minValue are computed in unsigned arithmetic, so ranges
+    // wider than INT_MAX do not overflow.
+    static inline uint32_t offsetOf(int value, int minValue) {
+        return static_cast<uint32_t>(value) - static_cast<uint32_t>(minValue);
+    }
+
+    static void expand(const uint32_t* counts, uint32_t span, int base, int* out) {
+        for (uint32_t k = 0; k < span; k++) {
+            out = std::fill_n(out, counts[k], static_cast<int>(static_cast<uint32_t>(base) + k));
+        }
+    }
+
+    static void sortDirect(int* arr, int size, int minValue, uint32_t span) {
+        std::vector<uint32_t> counts(span);
+        for (int i = 0; i < size; i++) {
+            counts[offsetOf(arr[i], minValue)]++;
+        }
+        expand(counts.data(), span, minValue, arr);
+    }
+
+    static void sortBlocked(int* arr, int size, int minValue, uint64_t span, int blockShift) {
+        const uint32_t blockCount = static_cast<uint32_t>((span - 1) >> blockShift) + 1;
+        std::vector<uint32_t> blockStarts(blockCount + 1);
+        for (int i = 0; i < size; i++) {
+            blockStarts[(offsetOf(arr[i], minValue) >> blockShift) + 1]++;
+        }
+        for (uint32_t b = 0; b < blockCount; b++) {
+            blockStarts[b + 1] += blockStarts[b];
+        }
+
+        std::vector<int> scratch(size);
+        std::vector<uint32_t> cursor(blockStarts.begin(), blockStarts.end() - 1);
+        for (int i = 0; i < size; i++) {
+            scratch[cursor[offsetOf(arr[i], minValue) >> blockShift]++] = arr[i];
+        }
+
+        const uint32_t blockSpan = 1u << blockShift;
+        std::vector<uint32_t> counts(blockSpan);
+        for (uint32_t b = 0; b < blockCount; b++) {
+            uint32_t begin = blockStarts[b];
+            uint32_t end = blockStarts[b + 1];
+            uint32_t spanHere = static_cast<uint32_t>(std::min<uint64_t>(blockSpan, span - (uint64_t(b) << blockShift)));
+            if ((end - begin) * kMaxValuesPerElement < spanHere) {
+                // Too sparse to be worth clearing and scanning a histogram.
+                std::copy(scratch.begin() + begin, scratch.begin() + end, arr + begin);
+                quickSort3To8(arr + begin, end - begin);
+                continue;
+            }
+            std::fill(counts.begin(), counts.end(), 0);
+            for (uint32_t i = begin; i < end; i++) {
+                counts[offsetOf(scratch[i], minValue) & (blockSpan - 1)]++;
+            }
+            int base = static_cast<int>(static_cast<uint32_t>(minValue) + (b << blockShift));
+            expand(counts.data(), spanHere, base, arr + begin);
+        }
+    }
+
+    // log2 of the largest power-of-two histogram that fits in half of L2.
+    static int blockShiftForCache() {
+        size_t entries = detectCacheSizes().l2 / 2 / sizeof(uint32_t);
+        int shift = 10;
+        while ((size_t(2) << shift) <= entries) shift++;
+        return shift;
+    }
+}
+
+void findRange(const int* arr, int size, int* minValue, int* maxValue) {
+    int low = arr[0];
+    int high = arr[0];
+    int i = 0;
+#ifdef __SSE2__
+    // SSE2 has no pminsd/pmaxsd, so min and max are built from a compare and
+    // a select. Two accumulators per side hide the compare latency.
+    if (size >= 8) {
+        __m128i min0 = _mm_set1_epi32(low), min1 = min0, max0 = min0, max1 = min0;
+        auto select = [](__m128i mask, __m128i a, __m128i b) {
+            return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+        };
+        for (; i + 8 <= size; i += 8) {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(arr + i));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(arr + i + 4));
+            min0 = select(_mm_cmplt_epi32(a, min0), a, min0);
+            min1 = select(_mm_cmplt_epi32(b, min1), b, min1);
+            max0 = select(_mm_cmpgt_epi32(a, max0), a, max0);
+            max1 = select(_mm_cmpgt_epi32(b, max1), b, max1);
+        }
+        min0 = select(_mm_cmplt_epi32(min1, min0), min1, min0);
+        max0 = select(_mm_cmpgt_epi32(max1, max0), max1, max0);
+        alignas(16) int lanes[8];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), min0);
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes + 4), max0);
+        low = *std::min_element(lanes, lanes + 4);
+        high = *std::max_element(lanes + 4, lanes + 8);
+    }
+#endif
+    for (; i < size; i++) {
+        low = std::min(low, arr[i]);
+        high = std::max(high, arr[i]);
+    }
+    *minValue = low;
+    *maxValue = high;
+}
+
+bool shouldUseCountingSort(int size, int minValue, int maxValue) {
+    int64_t span = int64_t(maxValue) - minValue + 1;
+    return size >= counting::kMinSize && span <= counting::kMaxValuesPerElement * size;
+}
+
+void countingSort(int* arr, int size, int minValue, int maxValue) {
+    if (size <= 1) return;
+    uint64_t span = uint64_t(int64_t(maxValue) - minValue) + 1;
+    int blockShift = counting::blockShiftForCache();
+    if (span <= (uint64_t(1) << blockShift)) {
+        counting::sortDirect(arr, size, minValue, static_cast<uint32_t>(span));
+    } else {
+        counting::sortBlocked(arr, size, minValue, span, blockShift);
+    }
+}
+
+void countingSort3To8(int* arr, int size) {
+    if (size <= 1) return;
+    int minValue, maxValue;
+    findRange(arr, size, &minValue, &maxValue);
+    if (shouldUseCountingSort(size, minValue, maxValue)) {
+        countingSort(arr, size, minValue, maxValue);
+    } else {
+        quickSort3To8(arr, size);
+    }
+}
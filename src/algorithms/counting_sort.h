@@ -0,0 +1,26 @@
+#ifndef COUNTING_SORT_H_
+#define COUNTING_SORT_H_
+
+// Counting sort for arrays whose value range is small relative to their
+// size.
+
+// Smallest and largest value of a non-empty array, in one SSE2 pass.
+void findRange(const int* arr, int size, int* minValue, int* maxValue);
+
+// The fallback decision used by countingSort3To8: counting sort runs when
+// there are at least 256 elements and the range holds at most 8 values per
+// element (max - min + 1 <= 8 * size).
+bool shouldUseCountingSort(int size, int minValue, int maxValue);
+
+// Counting sort of values known to lie in [minValue, maxValue]. Histograms
+// larger than half of L2 are built block by block: values are first
+// distributed by their high bits into L2-sized ranges of a scratch buffer,
+// then each range is counted and written back with its own histogram (or
+// sorted with quickSort3To8 when it holds too few values to pay for one).
+void countingSort(int* arr, int size, int minValue, int maxValue);
+
+// Detects the range, then runs countingSort when shouldUseCountingSort
+// allows it and quickSort3To8 otherwise.
+void countingSort3To8(int* arr, int size);
+
+#endif
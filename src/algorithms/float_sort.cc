@@ -0,0 +1,60 @@
+#include "float_sort.h"
+#include "generic_sort.h"
+#include "merge_sort_variants.h"
+#include "quick_sort_variants.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// The sort treats the buffer as integer storage between the two transforms.
+typedef int32_t __attribute__((may_alias)) AliasedInt32;
+typedef int64_t __attribute__((may_alias)) AliasedInt64;
+
+namespace float_keys {
+    template<typename Float>
+    static int moveNaNsToEnd(Float* arr, int size) {
+        return std::partition(arr, arr + size, [](Float value) { return !std::isnan(value); }) - arr;
+    }
+
+    // Negative values keep the sign bit and get their magnitude bits
+    // inverted, which reverses their order; applying it twice is the
+    // identity, so the same loop maps back.
+    static int32_t* toggleKeys(float* arr, int size) {
+        AliasedInt32* keys = reinterpret_cast<AliasedInt32*>(arr);
+        for (int i = 0; i < size; i++) {
+            keys[i] ^= (keys[i] >> 31) & INT32_MAX;
+        }
+        return reinterpret_cast<int32_t*>(arr);
+    }
+
+    static int64_t* toggleKeys(double* arr, int size) {
+        AliasedInt64* keys = reinterpret_cast<AliasedInt64*>(arr);
+        for (int i = 0; i < size; i++) {
+            keys[i] ^= (keys[i] >> 63) & INT64_MAX;
+        }
+        return reinterpret_cast<int64_t*>(arr);
+    }
+
+    template<typename Float, typename SortKeys>
+    static void sortThroughKeys(Float* arr, int size, SortKeys sortKeys) {
+        int count = moveNaNsToEnd(arr, size);
+        sortKeys(toggleKeys(arr, count), count);
+        toggleKeys(arr, count);
+    }
+}
+
+void mergeSort3To8(float* arr, int size) {
+    float_keys::sortThroughKeys(arr, size, [](int32_t* keys, int count) { mergeSort3To8(keys, count); });
+}
+
+void quickSort3To8(float* arr, int size) {
+    float_keys::sortThroughKeys(arr, size, [](int32_t* keys, int count) { quickSort3To8(keys, count); });
+}
+
+void mergeSort3To8(double* arr, int size) {
+    float_keys::sortThroughKeys(arr, size, [](int64_t* keys, int count) { generic::mergeSort(keys, count); });
+}
+
+void quickSort3To8(double* arr, int size) {
+    float_keys::sortThroughKeys(arr, size, [](int64_t* keys, int count) { generic::quickSort(keys, count); });
+}
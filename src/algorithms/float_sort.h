@@ -0,0 +1,17 @@
+#ifndef FLOAT_SORT_H_
+#define FLOAT_SORT_H_
+
+// Floating-point entry points for the integer engines. Values are mapped in
+// place to integer keys whose signed order matches IEEE-754 total order
+// (negatives get every bit but the sign inverted, so -0.0 sorts before +0.0),
+// sorted, and mapped back. NaNs are moved to the end first,
+// bits untouched. Floats run on the 3-8 AlphaDev network engines; doubles
+// need 64-bit keys, which the 32-bit AlphaDev kernels cannot take, so they
+// run on the generic engines with comparator-driven network leaves.
+void mergeSort3To8(float* arr, int size);
+void quickSort3To8(float* arr, int size);
+
+void mergeSort3To8(double* arr, int size);
+void quickSort3To8(double* arr, int size);
+
+#endif
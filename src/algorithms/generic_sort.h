@@ -0,0 +1,237 @@
+#ifndef GENERIC_SORT_H_
+#define GENERIC_SORT_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "sort_configs.h"
+
+// Header-only merge and quick sort engines over any element type, ordered by
+// compare(projection(a), projection(b)). They reuse the int engines' leaf
+// configs: when the elements themselves are 32-bit ints compared with
+// std::less (or std::greater, by sorting the bitwise complement) the leaves go
+// to the config's AlphaDev networks; every other ordering uses the same
+// network shapes built from comparator-driven compare-exchanges (size-optimal
+// for quick sort, odd-even transposition for the stable merge sort).
+// Elements must be default constructible and movable.
+
+struct Identity {
+    template<typename T>
+    constexpr T&& operator()(T&& value) const noexcept {
+        return std::forward<T>(value);
+    }
+};
+
+namespace generic_networks {
+    // Compare-exchange pairs for sizes 2-8, in execution order.
+    const int8_t kPairs2[][2] = {{0, 1}};
+    const int8_t kPairs3[][2] = {{0, 2}, {0, 1}, {1, 2}};
+    const int8_t kPairs4[][2] = {{0, 2}, {1, 3}, {0, 1}, {2, 3}, {1, 2}};
+    const int8_t kPairs5[][2] = {{0, 3}, {1, 4}, {0, 2}, {1, 3}, {0, 1}, {2, 4}, {1, 2}, {3, 4}, {2, 3}};
+    const int8_t kPairs6[][2] = {{0, 5}, {1, 3}, {2, 4}, {1, 2}, {3, 4}, {0, 3},
+                                 {2, 5}, {0, 1}, {2, 3}, {4, 5}, {1, 2}, {3, 4}};
+    const int8_t kPairs7[][2] = {{0, 6}, {2, 3}, {4, 5}, {0, 2}, {1, 4}, {3, 6}, {0, 1}, {2, 5},
+                                 {3, 4}, {1, 2}, {4, 6}, {2, 3}, {4, 5}, {1, 2}, {3, 4}, {5, 6}};
+    const int8_t kPairs8[][2] = {{0, 2}, {1, 3}, {4, 6}, {5, 7}, {0, 4}, {1, 5}, {2, 6},
+                                 {3, 7}, {0, 1}, {2, 3}, {4, 5}, {6, 7}, {2, 4}, {3, 5},
+                                 {1, 4}, {3, 6}, {1, 2}, {3, 4}, {5, 6}};
+
+    template<typename T, typename Less, size_t N>
+    void apply(T* arr, const int8_t (&pairs)[N][2], Less& less) {
+        for (size_t p = 0; p < N; p++) {
+            T& a = arr[pairs[p][0]];
+            T& b = arr[pairs[p][1]];
+            if (less(b, a)) std::swap(a, b);
+        }
+    }
+
+    // Odd-even transposition network: only adjacent elements are compared,
+    // so equal elements never pass each other and the result is stable.
+    template<typename T, typename Less>
+    void sortStable(T* arr, int size, Less& less) {
+        for (int round = 0; round < size; round++) {
+            for (int k = round & 1; k + 1 < size; k += 2) {
+                if (less(arr[k + 1], arr[k])) std::swap(arr[k], arr[k + 1]);
+            }
+        }
+    }
+
+    template<typename T, typename Less>
+    void sort(T* arr, int size, Less& less) {
+        switch (size) {
+            case 2: apply(arr, kPairs2, less); return;
+            case 3: apply(arr, kPairs3, less); return;
+            case 4: apply(arr, kPairs4, less); return;
+            case 5: apply(arr, kPairs5, less); return;
+            case 6: apply(arr, kPairs6, less); return;
+            case 7: apply(arr, kPairs7, less); return;
+            case 8: apply(arr, kPairs8, less); return;
+        }
+    }
+}
+
+namespace generic {
+    template<typename T, typename Compare, typename Projection>
+    struct Ordering {
+        Compare compare;
+        Projection projection;
+
+        bool operator()(const T& a, const T& b) {
+            return std::invoke(compare, std::invoke(projection, a), std::invoke(projection, b));
+        }
+
+        static constexpr bool kIntElements =
+            std::is_same<T, int32_t>::value && std::is_same<Projection, Identity>::value;
+        static constexpr bool kAscendingInt = kIntElements &&
+            (std::is_same<Compare, std::less<>>::value || std::is_same<Compare, std::less<int32_t>>::value);
+        static constexpr bool kDescendingInt = kIntElements &&
+            (std::is_same<Compare, std::greater<>>::value || std::is_same<Compare, std::greater<int32_t>>::value);
+    };
+
+    // Equal ints are indistinguishable, so the AlphaDev paths are stable in
+    // effect; other types use the stable network when Stable is set.
+    template<typename Config, bool Stable, typename T, typename Compare, typename Projection>
+    void sortLeaf(T* arr, int size, Ordering<T, Compare, Projection>& less) {
+        using Order = Ordering<T, Compare, Projection>;
+        if constexpr (Order::kAscendingInt) {
+            Config::applySortingNetwork(arr, size);
+        } else if constexpr (Order::kDescendingInt) {
+            // ~x reverses the order of every int, INT_MIN included.
+            for (int k = 0; k < size; k++) arr[k] = ~arr[k];
+            Config::applySortingNetwork(arr, size);
+            for (int k = 0; k < size; k++) arr[k] = ~arr[k];
+        } else if constexpr (Stable) {
+            generic_networks::sortStable(arr, size, less);
+        } else {
+            generic_networks::sort(arr, size, less);
+        }
+    }
+
+    template<typename Config, typename T, typename Compare = std::less<>, typename Projection = Identity>
+    class MergeSortVariant {
+    private:
+        using Order = Ordering<T, Compare, Projection>;
+
+        // Stable: on ties the element from the left run is taken first.
+        static void merge(T* arr, int left, int mid, int right, T* buffer, Order& less) {
+            int n1 = mid - left + 1;
+            std::move(arr + left, arr + mid + 1, buffer);
+
+            int i = 0, j = mid + 1, k = left;
+            while (i < n1 && j <= right) {
+                if (less(arr[j], buffer[i])) {
+                    arr[k] = std::move(arr[j]);
+                    j++;
+                } else {
+                    arr[k] = std::move(buffer[i]);
+                    i++;
+                }
+                k++;
+            }
+            std::move(buffer + i, buffer + n1, arr + k);
+        }
+
+        static void mergeSortRecursive(T* arr, int left, int right, T* buffer, Order& less) {
+            int size = right - left + 1;
+
+            if (Config::shouldUseNetwork(size)) {
+                sortLeaf<Config, true>(arr + left, size, less);
+                return;
+            }
+
+            if (left < right) {
+                int mid = left + (right - left) / 2;
+                mergeSortRecursive(arr, left, mid, buffer, less);
+                mergeSortRecursive(arr, mid + 1, right, buffer, less);
+                merge(arr, left, mid, right, buffer, less);
+            }
+        }
+
+    public:
+        static void sort(T* arr, int size, Compare compare = Compare(), Projection projection = Projection()) {
+            if (size <= 1) return;
+            Order less{compare, projection};
+            std::vector<T> buffer(size - size / 2);
+            mergeSortRecursive(arr, 0, size - 1, buffer.data(), less);
+        }
+    };
+
+    template<typename Config, typename T, typename Compare = std::less<>, typename Projection = Identity>
+    class QuickSortVariant {
+    private:
+        using Order = Ordering<T, Compare, Projection>;
+
+        static int getMedianOfThree(T* arr, int low, int high, Order& less) {
+            int mid = low + (high - low) / 2;
+            if (less(arr[mid], arr[low])) std::swap(arr[low], arr[mid]);
+            if (less(arr[high], arr[mid])) std::swap(arr[mid], arr[high]);
+            if (less(arr[mid], arr[low])) std::swap(arr[low], arr[mid]);
+            return mid;
+        }
+
+        // The pivot is parked at low and compared in place, since T may be
+        // move-only, then swapped into its final slot, which is returned.
+        static int hoarePartition(T* arr, int low, int high, int pivotIndex, Order& less) {
+            std::swap(arr[low], arr[pivotIndex]);
+            const T& pivot = arr[low];
+            int i = low;
+            int j = high + 1;
+
+            while (true) {
+                do {
+                    i++;
+                } while (i <= high && less(arr[i], pivot));
+
+                do {
+                    j--;
+                } while (less(pivot, arr[j]));
+
+                if (i >= j) break;
+                std::swap(arr[i], arr[j]);
+            }
+            std::swap(arr[low], arr[j]);
+            return j;
+        }
+
+        static void quickSortRecursive(T* arr, int low, int high, Order& less) {
+            int size = high - low + 1;
+
+            if (Config::shouldUseNetwork(size)) {
+                sortLeaf<Config, false>(arr + low, size, less);
+                return;
+            }
+
+            if (low < high) {
+                int pivotIndex = getMedianOfThree(arr, low, high, less);
+                int pi = hoarePartition(arr, low, high, pivotIndex, less);
+                quickSortRecursive(arr, low, pi - 1, less);
+                quickSortRecursive(arr, pi + 1, high, less);
+            }
+        }
+
+    public:
+        static void sort(T* arr, int size, Compare compare = Compare(), Projection projection = Projection()) {
+            Order less{compare, projection};
+            quickSortRecursive(arr, 0, size - 1, less);
+        }
+    };
+
+    // The projection may be any callable or a data member pointer, e.g.
+    // generic::mergeSort(people, n, std::greater<>(), &Person::age).
+    template<typename Config = configs::Current3To8Config, typename T, typename Compare = std::less<>,
+             typename Projection = Identity>
+    void mergeSort(T* arr, int size, Compare compare = Compare(), Projection projection = Projection()) {
+        MergeSortVariant<Config, T, Compare, Projection>::sort(arr, size, compare, projection);
+    }
+
+    template<typename Config = configs::Current3To8Config, typename T, typename Compare = std::less<>,
+             typename Projection = Identity>
+    void quickSort(T* arr, int size, Compare compare = Compare(), Projection projection = Projection()) {
+        QuickSortVariant<Config, T, Compare, Projection>::sort(arr, size, compare, projection);
+    }
+}
+
+#endif
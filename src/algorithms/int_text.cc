@@ -0,0 +1,118 @@
+#include "int_text.h"
+#include <cstdint>
+#include <cstring>
+
+namespace int_text {
+    static const uint64_t kOnes = 0x0101010101010101ULL;
+    static const uint64_t kLimit = 2147483648ULL;
+
+    static const char kDigitPairs[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+
+    // True when all eight bytes of a little-endian word are '0'-'9'.
+    static inline bool allDigits(uint64_t word) {
+        return ((word & 0xF0F0F0F0F0F0F0F0ULL) | (((word + 0x06 * kOnes) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+               0x3333333333333333ULL;
+    }
+
+    // Value of eight ASCII digits loaded little-endian (first digit in the low
+    // byte): adjacent digits are combined into pairs, pairs into quads, quads
+    // into the result.
+    static inline uint32_t eightDigits(uint64_t word) {
+        word -= 0x30 * kOnes;
+        word = (word * 10 + (word >> 8)) & 0x00FF00FF00FF00FFULL;
+        word = (word * 100 + (word >> 16)) & 0x0000FFFF0000FFFFULL;
+        return static_cast<uint32_t>((word * 10000 + (word >> 32)) & 0xFFFFFFFFULL);
+    }
+
+    static inline bool isLittleEndian() {
+        return __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+    }
+
+    // Parses the digits at p, stopping at the first non-digit. Returns false
+    // if there are none or the magnitude exceeds 2^31.
+    static inline bool parseDigits(const char*& p, const char* end, uint64_t& magnitude) {
+        const char* start = p;
+        uint64_t value = 0;
+        if (isLittleEndian()) {
+            while (end - p >= 8) {
+                uint64_t word;
+                std::memcpy(&word, p, 8);
+                if (!allDigits(word)) break;
+                value = value * 100000000 + eightDigits(word);
+                if (value > kLimit) return false;
+                p += 8;
+            }
+        }
+        while (p < end && static_cast<unsigned>(*p - '0') < 10) {
+            value = value * 10 + (*p - '0');
+            if (value > kLimit) return false;
+            p++;
+        }
+        magnitude = value;
+        return p != start;
+    }
+
+    static inline char* formatUnsigned(uint32_t value, char* out) {
+        int digits = 1;
+        for (uint32_t v = value; v >= 10; v /= 10) digits++;
+        char* p = out + digits;
+        while (value >= 100) {
+            uint32_t pair = value % 100;
+            value /= 100;
+            p -= 2;
+            std::memcpy(p, kDigitPairs + 2 * pair, 2);
+        }
+        if (value >= 10) {
+            std::memcpy(p - 2, kDigitPairs + 2 * value, 2);
+        } else {
+            p[-1] = static_cast<char>('0' + value);
+        }
+        return out + digits;
+    }
+}
+
+bool parseIntegerLines(const char* begin, const char* end, std::vector<int>& out, const char** errorAt) {
+    using namespace int_text;
+    const char* p = begin;
+    while (p < end) {
+        const char* line = p;
+        if (*p == '\n') {
+            p++;
+            continue;
+        }
+        if (*p == '\r' && p + 1 < end && p[1] == '\n') {
+            p += 2;
+            continue;
+        }
+
+        bool negative = *p == '-';
+        if (negative || *p == '+') p++;
+        uint64_t magnitude;
+        bool ok = parseDigits(p, end, magnitude) && (negative || magnitude < kLimit);
+        if (ok && p < end && *p == '\r') p++;
+        if (!ok || (p < end && *p != '\n')) {
+            if (errorAt) *errorAt = line;
+            return false;
+        }
+        if (p < end) p++;
+        out.push_back(static_cast<int>(negative ? 0 - magnitude : magnitude));
+    }
+    return true;
+}
+
+size_t formatIntegerLines(const int* arr, int size, char* out) {
+    char* p = out;
+    for (int i = 0; i < size; i++) {
+        uint32_t magnitude = static_cast<uint32_t>(arr[i]);
+        if (arr[i] < 0) {
+            *p++ = '-';
+            magnitude = 0 - magnitude;
+        }
+        p = int_text::formatUnsigned(magnitude, p);
+        *p++ = '\n';
+    }
+    return p - out;
+}
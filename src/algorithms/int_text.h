@@ -0,0 +1,25 @@
+#ifndef INT_TEXT_H_
+#define INT_TEXT_H_
+
+#include <cstddef>
+#include <vector>
+
+// Newline-delimited decimal int32 text, parsed and formatted without
+// iostreams or locale lookups.
+
+// Longest formatted line: "-2147483648\n".
+const int kMaxIntegerLineChars = 12;
+
+// Appends one value per line of [begin, end) to `out`. A line is an optional
+// sign and at least one digit, optionally followed by '\r'; empty lines are
+// skipped and the last line need not end in '\n'. Runs of eight digits are
+// validated and converted eight at a time within a 64-bit word. Returns false
+// on a malformed or out-of-range line and points *errorAt at its start; the
+// values before it have been appended.
+bool parseIntegerLines(const char* begin, const char* end, std::vector<int>& out, const char** errorAt);
+
+// Writes each value followed by '\n' to `out`, which must have room for
+// size * kMaxIntegerLineChars chars, and returns the number written.
+size_t formatIntegerLines(const int* arr, int size, char* out);
+
+#endif
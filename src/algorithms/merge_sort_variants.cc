@@ -1,221 +1,475 @@
 #include "merge_sort_variants.h"
+#include "sort_configs.h"
 #include "sorting_networks.h"
+#include "sort_stats.h"
+#include "cache_info.h"
+#include "prefetch.h"
 #include <vector>
 #include <algorithm>
 #include <cstring>
+#include <climits>
+#include <cstdint>
 
-void merge(int* arr, int left, int mid, int right) {
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Only the left run is copied out to `buffer`; the right run is consumed in
+// place because the write position never overtakes it. With Prefetch, each
+// time a stream crosses a cache line the line `distance` elements ahead on
+// that stream is requested.
+template<bool Prefetch>
+static void mergeRuns(int* arr, int left, int mid, int right, int* buffer, int distance) {
     int n1 = mid - left + 1;
-    int n2 = right - mid;
-    
-    std::vector<int> L(n1), R(n2);
     
-    for(int i = 0; i < n1; i++)
-        L[i] = arr[left + i];
-    for(int j = 0; j < n2; j++)
-        R[j] = arr[mid + 1 + j];
+    std::copy(arr + left, arr + mid + 1, buffer);
     
-    int i = 0, j = 0, k = left;
+    int i = 0, j = mid + 1, k = left;
     
-    while (i < n1 && j < n2) {
-        if (L[i] <= R[j]) {
-            arr[k] = L[i];
+    while (i < n1 && j <= right) {
+        if (Prefetch && k % kPrefetchStride == 0) {
+            prefetchRead(buffer + std::min(i + distance, n1 - 1));
+            prefetchRead(arr + std::min(j + distance, right));
+            prefetchWrite(arr + std::min(k + distance, right));
+        }
+        sort_stats::countComparison();
+        if (buffer[i] <= arr[j]) {
+            arr[k] = buffer[i];
             i++;
         } else {
-            arr[k] = R[j];
+            arr[k] = arr[j];
             j++;
         }
         k++;
     }
     
     while (i < n1) {
-        arr[k] = L[i];
+        arr[k] = buffer[i];
         i++;
         k++;
     }
+    sort_stats::countMerged(k - left);
+}
+
+void merge(int* arr, int left, int mid, int right, int* buffer, int prefetchDistance) {
+    if (prefetchDistance > 0 && right - left + 1 >= kPrefetchMinElements) {
+        mergeRuns<true>(arr, left, mid, right, buffer, prefetchDistance);
+    } else {
+        mergeRuns<false>(arr, left, mid, right, buffer, 0);
+    }
+}
+
+// Merge for outputs far larger than the LLC: results are written with
+// non-temporal stores, so the destination lines are not read for ownership
+// and do not evict useful data. Scalar stores cover the unaligned head and
+// the tail; the aligned body streams four results at a time.
+static void mergeStreaming(int* arr, int left, int mid, int right, int* buffer) {
+#ifdef __SSE2__
+    int n1 = mid - left + 1;
+    
+    std::copy(arr + left, arr + mid + 1, buffer);
+    
+    int i = 0, j = mid + 1, k = left;
+    auto next = [&]() {
+        if (j <= right) sort_stats::countComparison();
+        if (j > right || buffer[i] <= arr[j]) return buffer[i++];
+        return arr[j++];
+    };
+    
+    // Right-run elements still unread always sit at or after position
+    // k + (n1 - i), so a staged group of four never overwrites one of them.
+    while (i < n1 && reinterpret_cast<uintptr_t>(arr + k) % 16 != 0) {
+        arr[k] = next();
+        k++;
+    }
+    while (i < n1 && right - k + 1 >= 4) {
+        alignas(16) int group[4];
+        for (int g = 0; g < 4; g++) {
+            group[g] = i < n1 ? next() : arr[j++];
+        }
+        _mm_stream_si128(reinterpret_cast<__m128i*>(arr + k),
+                         _mm_load_si128(reinterpret_cast<const __m128i*>(group)));
+        k += 4;
+    }
+    while (i < n1) {
+        arr[k] = next();
+        k++;
+    }
+    _mm_sfence();
+    sort_stats::countMerged(k - left);
+#else
+    merge(arr, left, mid, right, buffer);
+#endif
+}
+
+void merge(int* arr, int left, int mid, int right) {
+    std::vector<int> buffer(mid - left + 1);
+    merge(arr, left, mid, right, buffer.data());
+}
+
+// Merges the duplicate-free runs arr[left, left + n1) and
+// arr[rightStart, rightStart + n2) into arr[left, ...), writing each distinct
+// value once, and returns the merged length. Duplicates already dropped leave
+// a gap before rightStart, so the write position still never overtakes the
+// right run.
+static int mergeUniqueRuns(int* arr, int left, int n1, int rightStart, int n2, int* buffer) {
+    std::copy(arr + left, arr + left + n1, buffer);
+    
+    int i = 0, j = rightStart, k = left;
+    int end = rightStart + n2;
+    
+    while (i < n1 && j < end) {
+        sort_stats::countComparison();
+        // Equal heads write one copy and advance both runs.
+        int a = buffer[i];
+        int b = arr[j];
+        arr[k] = a < b ? a : b;
+        i += a <= b;
+        j += b <= a;
+        k++;
+    }
     
-    while (j < n2) {
-        arr[k] = R[j];
+    while (i < n1) {
+        arr[k] = buffer[i];
+        i++;
+        k++;
+    }
+    while (j < end) {
+        arr[k] = arr[j];
         j++;
         k++;
     }
+    sort_stats::countMerged(k - left);
+    return k - left;
 }
 
-namespace configs {
-    struct ClassicConfig {
-        static bool shouldUseNetwork(int size) {
-            return size <= 1;
-        }
-        
-        static void applySortingNetwork(int* arr, int size) {}
-    };
+// Runs this short are merged through a fixed stack cache; longer ones are
+// split by rotation until they are.
+const int kInPlaceCacheSize = 256;
 
-    struct Current3To8Config {
-        static bool shouldUseNetwork(int size) {
-            return size <= 8 && size != 2;
-        }
-        
-        static void applySortingNetwork(int* arr, int size) {
-            switch(size) {
-                case 1: return;
-                case 3: Sort3AlphaDev(arr); return;
-                case 4: Sort4AlphaDev(arr); return;
-                case 5: Sort5AlphaDev(arr); return;
-                case 6: Sort6AlphaDev(arr); return;
-                case 7: Sort7AlphaDev(arr); return;
-                case 8: Sort8AlphaDev(arr); return;
-            }
+// Mirror of mergeRuns for a short right run: it is copied out and the merge
+// fills arr from the back, so the left run is consumed in place.
+static void mergeRunsBackward(int* arr, int left, int mid, int right, int* buffer) {
+    int n2 = right - mid;
+    
+    std::copy(arr + mid + 1, arr + right + 1, buffer);
+    
+    int i = mid, j = n2 - 1, k = right;
+    
+    while (i >= left && j >= 0) {
+        sort_stats::countComparison();
+        if (arr[i] > buffer[j]) {
+            arr[k] = arr[i];
+            i--;
+        } else {
+            arr[k] = buffer[j];
+            j--;
         }
-    };
+        k--;
+    }
+    
+    while (j >= 0) {
+        arr[k] = buffer[j];
+        j--;
+        k--;
+    }
+    sort_stats::countMerged(right - k);
+}
 
-    struct Network3Config {
-        static bool shouldUseNetwork(int size) {
-            return size == 3;
-        }
+// Stable merge without a heap buffer. While both runs are longer than the
+// cache, the middle of the longer run is matched by binary search in the
+// other, the two inner blocks are swapped with a rotation, and the two
+// resulting merges are solved independently: the shorter one recursively,
+// the longer one by looping, so the stack stays O(log n).
+void mergeInPlace(int* arr, int left, int mid, int right) {
+    int cache[kInPlaceCacheSize];
+    while (left <= mid && mid < right) {
+        sort_stats::countComparison();
+        if (arr[mid] <= arr[mid + 1]) return;
         
-        static void applySortingNetwork(int* arr, int size) {
-            switch(size) {
-                case 1: return;
-                case 3: Sort3AlphaDev(arr); return;
-            }
+        int n1 = mid - left + 1;
+        int n2 = right - mid;
+        if (n1 <= kInPlaceCacheSize) {
+            mergeRuns<false>(arr, left, mid, right, cache, 0);
+            return;
         }
-    };
-
-    struct Networks3To4Config {
-        static bool shouldUseNetwork(int size) {
-            return size <= 4 && size != 2;
+        if (n2 <= kInPlaceCacheSize) {
+            mergeRunsBackward(arr, left, mid, right, cache);
+            return;
         }
         
-        static void applySortingNetwork(int* arr, int size) {
-            switch(size) {
-                case 1: return;
-                case 3: Sort3AlphaDev(arr); return;
-                case 4: Sort4AlphaDev(arr); return;
-            }
-        }
-    };
-
-    struct Networks3To5Config {
-        static bool shouldUseNetwork(int size) {
-            return size <= 5 && size != 2;
+        int leftCut, rightCut;
+        if (n1 >= n2) {
+            leftCut = left + n1 / 2;
+            rightCut = std::lower_bound(arr + mid + 1, arr + right + 1, arr[leftCut]) - arr;
+        } else {
+            rightCut = mid + 1 + n2 / 2;
+            leftCut = std::upper_bound(arr + left, arr + mid + 1, arr[rightCut]) - arr;
         }
+        std::rotate(arr + leftCut, arr + mid + 1, arr + rightCut);
+        sort_stats::countMerged(rightCut - leftCut);
+        int newMid = leftCut + (rightCut - mid - 1);
         
-        static void applySortingNetwork(int* arr, int size) {
-            switch(size) {
-                case 1: return;
-                case 3: Sort3AlphaDev(arr); return;
-                case 4: Sort4AlphaDev(arr); return;
-                case 5: Sort5AlphaDev(arr); return;
-            }
+        if (newMid - left < right - newMid) {
+            mergeInPlace(arr, left, leftCut - 1, newMid - 1);
+            left = newMid;
+            mid = rightCut - 1;
+        } else {
+            mergeInPlace(arr, newMid, rightCut - 1, right);
+            right = newMid - 1;
+            mid = leftCut - 1;
         }
-    };
+    }
+}
 
-    struct NetworksEvenConfig {
-        static bool shouldUseNetwork(int size) {
-            return size == 4 || size == 6 || size == 8;
-        }
-        
-        static void applySortingNetwork(int* arr, int size) {
-            switch(size) {
-                case 4: Sort4AlphaDev(arr); return;
-                case 6: Sort6AlphaDev(arr); return;
-                case 8: Sort8AlphaDev(arr); return;
-            }
-        }
+namespace multiway {
+    const int kMaxWays = 64;
+    const long long kExhausted = LLONG_MAX;
+
+    struct Run {
+        const int* cur;
+        const int* end;
     };
 
-    struct NetworksOddConfig {
-        static bool shouldUseNetwork(int size) {
-            return size < 8 && size % 2 != 0;
-        }
-        
-        static void applySortingNetwork(int* arr, int size) {
-            switch(size) {
-                case 3: Sort3AlphaDev(arr); return;
-                case 5: Sort5AlphaDev(arr); return;
-                case 7: Sort7AlphaDev(arr); return;
-            }
+    // Each run's head is packed with its run index into one key, so a single
+    // compare orders by value, breaks ties by run (stable) and sorts
+    // exhausted runs last.
+    static long long headKey(const Run& run, int index) {
+        if (run.cur == run.end) return kExhausted;
+        return static_cast<long long>(*run.cur) * kMaxWays + index;
+    }
+
+    static int buildLoserTree(const long long* keys, int* losers, int node, int leaves) {
+        if (node >= leaves) return node - leaves;
+        int left = buildLoserTree(keys, losers, 2 * node, leaves);
+        int right = buildLoserTree(keys, losers, 2 * node + 1, leaves);
+        if (keys[left] < keys[right]) {
+            losers[node] = right;
+            return left;
         }
-    };
+        losers[node] = left;
+        return right;
+    }
 
-    struct NetworksPowerOf2Config {
-        static bool shouldUseNetwork(int size) {
-            return size == 4 || size == 8;
+    // Loser-tree merge of up to kMaxWays sorted runs into `out`; each output
+    // element costs log2(ways) comparisons on the path from its leaf to the root.
+    static void merge(const Run* input, int ways, int* out) {
+        Run runs[kMaxWays];
+        long long keys[kMaxWays];
+        int losers[kMaxWays];
+        int leaves = 1;
+        while (leaves < ways) leaves *= 2;
+
+        long long total = 0;
+        for (int r = 0; r < leaves; r++) {
+            runs[r] = r < ways ? input[r] : Run{nullptr, nullptr};
+            keys[r] = headKey(runs[r], r);
+            total += runs[r].end - runs[r].cur;
         }
-        
-        static void applySortingNetwork(int* arr, int size) {
-            switch(size) {
-                case 4: Sort4AlphaDev(arr); return;
-                case 8: Sort8AlphaDev(arr); return;
+
+        int winner = buildLoserTree(keys, losers, 1, leaves);
+        for (long long t = 0; t < total; t++) {
+            out[t] = *runs[winner].cur++;
+            keys[winner] = headKey(runs[winner], winner);
+            for (int node = (winner + leaves) / 2; node >= 1; node /= 2) {
+                sort_stats::countComparison();
+                int challenger = losers[node];
+                bool swap = keys[challenger] < keys[winner];
+                losers[node] = swap ? winner : challenger;
+                winner = swap ? challenger : winner;
             }
         }
-    };
+        sort_stats::countMerged(static_cast<int>(total));
+    }
+}
 
-    struct VarSort3Config {
-        static bool shouldUseNetwork(int size) {
-            return size <= 3;
-        }
-        
-        static void applySortingNetwork(int* arr, int size) {
-            std::vector<int> newArr(size + 1);
-            newArr[0] = size;
-            std::copy(arr, arr + size, newArr.begin() + 1);
-            VarSort3AlphaDev(newArr.data());
-            std::copy(newArr.begin() + 1, newArr.end(), arr);
-        }
-    };
+// Opt-in memory-system tuning for the merges of MergeSortVariant.
+struct MergeTuning {
+    int prefetchDistance = 0;
+    // Merges whose output range exceeds this many bytes use non-temporal
+    // stores.
+    size_t streamingThresholdBytes = SIZE_MAX;
+};
 
-    struct VarSort4Config {
-        static bool shouldUseNetwork(int size) {
-            return size <= 4;
+template<typename Config>
+class MergeSortVariant {
+private:
+    static void mergeSortRecursive(int* arr, int left, int right, int* buffer, int depth,
+                                   const MergeTuning& tuning = MergeTuning()) {
+        int size = right - left + 1;
+        sort_stats::recordDepth(depth);
+        
+        if (Config::shouldUseNetwork(size)) {
+            sort_stats::countLeaf(size);
+            Config::applySortingNetwork(arr + left, size);
+            return;
         }
         
-        static void applySortingNetwork(int* arr, int size) {
-            std::vector<int> newArr(size + 1);
-            newArr[0] = size;
-            std::copy(arr, arr + size, newArr.begin() + 1);
-            VarSort4AlphaDev(newArr.data());
-            std::copy(newArr.begin() + 1, newArr.end(), arr);
+        if (left < right) {
+            int mid = left + (right - left) / 2;
+            mergeSortRecursive(arr, left, mid, buffer, depth + 1, tuning);
+            mergeSortRecursive(arr, mid + 1, right, buffer, depth + 1, tuning);
+            if (static_cast<size_t>(size) * sizeof(int) > tuning.streamingThresholdBytes) {
+                mergeStreaming(arr, left, mid, right, buffer);
+            } else {
+                merge(arr, left, mid, right, buffer, tuning.prefetchDistance);
+            }
         }
-    };
+    }
 
-    struct VarSort5Config {
-        static bool shouldUseNetwork(int size) {
-            return size <= 5;
+    static void mergeSortInPlaceRecursive(int* arr, int left, int right, int depth) {
+        int size = right - left + 1;
+        sort_stats::recordDepth(depth);
+        
+        if (Config::shouldUseNetwork(size)) {
+            sort_stats::countLeaf(size);
+            Config::applySortingNetwork(arr + left, size);
+            return;
         }
         
-        static void applySortingNetwork(int* arr, int size) {
-            std::vector<int> newArr(size + 1);
-            newArr[0] = size;
-            std::copy(arr, arr + size, newArr.begin() + 1);
-            VarSort5AlphaDev(newArr.data());
-            std::copy(newArr.begin() + 1, newArr.end(), arr);
+        if (left < right) {
+            int mid = left + (right - left) / 2;
+            mergeSortInPlaceRecursive(arr, left, mid, depth + 1);
+            mergeSortInPlaceRecursive(arr, mid + 1, right, depth + 1);
+            mergeInPlace(arr, left, mid, right);
         }
-    };
-}
+    }
 
-template<typename Config>
-class MergeSortVariant {
-private:
-    static void mergeSortRecursive(int* arr, int left, int right) {
+    // Returns the number of distinct values, which end up sorted at the
+    // start of [left, right].
+    static int mergeSortUniqueRecursive(int* arr, int left, int right, int* buffer, int depth) {
         int size = right - left + 1;
+        sort_stats::recordDepth(depth);
         
         if (Config::shouldUseNetwork(size)) {
+            sort_stats::countLeaf(size);
             Config::applySortingNetwork(arr + left, size);
-            return;
+            return std::unique(arr + left, arr + right + 1) - (arr + left);
         }
         
         if (left < right) {
             int mid = left + (right - left) / 2;
-            mergeSortRecursive(arr, left, mid);
-            mergeSortRecursive(arr, mid + 1, right);
-            merge(arr, left, mid, right);
+            int n1 = mergeSortUniqueRecursive(arr, left, mid, buffer, depth + 1);
+            int n2 = mergeSortUniqueRecursive(arr, mid + 1, right, buffer, depth + 1);
+            return mergeUniqueRuns(arr, left, n1, mid + 1, n2, buffer);
         }
+        return size;
     }
 
 public:
+    // Cache-aware mode: fully sorts tiles of `tileSize` elements in cache,
+    // then combines up to `ways` tiles per pass with a multiway merge,
+    // ping-ponging between arr and an n-element scratch buffer.
+    static void sortTiled(int* arr, int size, int tileSize, int ways, SortScratch& scratch) {
+        if (size <= tileSize) {
+            sort(arr, size, scratch);
+            return;
+        }
+        ways = std::max(2, std::min(ways, multiway::kMaxWays));
+        int* buffer = scratch.acquire(size);
+
+        for (int start = 0; start < size; start += tileSize) {
+            int end = std::min(start + tileSize, size) - 1;
+            mergeSortRecursive(arr, start, end, buffer, 1);
+        }
+
+        int* src = arr;
+        int* dst = buffer;
+        for (long long runLength = tileSize; runLength < size; runLength *= ways) {
+            for (long long start = 0; start < size; start += runLength * ways) {
+                multiway::Run runs[multiway::kMaxWays];
+                int count = 0;
+                for (long long runStart = start; runStart < size && count < ways; runStart += runLength) {
+                    long long runEnd = std::min<long long>(runStart + runLength, size);
+                    runs[count++] = {src + runStart, src + runEnd};
+                }
+                multiway::merge(runs, count, dst + start);
+            }
+            std::swap(src, dst);
+        }
+        if (src != arr) {
+            std::memcpy(arr, src, size * sizeof(int));
+        }
+    }
+
+    // Tiles take half of L2 (their merge scratch needs another quarter) and the
+    // fan-in is chosen so every input run keeps about eight lines in L1.
+    static void sortCacheAware(int* arr, int size, SortScratch& scratch) {
+        const CacheSizes& caches = detectCacheSizes();
+        int tileSize = static_cast<int>(std::max<size_t>(caches.l2 / 2 / sizeof(int), 1024));
+        int ways = static_cast<int>(caches.l1d / (8 * 64));
+        sortTiled(arr, size, tileSize, ways, scratch);
+    }
+
+    static void sort(int* arr, int size, SortScratch& scratch, const MergeTuning& tuning = MergeTuning()) {
+        if (size <= 1) return;
+        int* buffer = scratch.acquire(size - size / 2);
+        mergeSortRecursive(arr, 0, size - 1, buffer, 0, tuning);
+    }
+
     static void sort(int* arr, int size) {
-        mergeSortRecursive(arr, 0, size - 1);
+        SortScratch scratch;
+        sort(arr, size, scratch);
+    }
+
+    static int sortUnique(int* arr, int size, SortScratch& scratch) {
+        if (size <= 1) return std::max(size, 0);
+        int* buffer = scratch.acquire(size - size / 2);
+        return mergeSortUniqueRecursive(arr, 0, size - 1, buffer, 0);
+    }
+
+    static void sortInPlace(int* arr, int size) {
+        if (size <= 1) return;
+        mergeSortInPlaceRecursive(arr, 0, size - 1, 0);
+    }
+
+    // Natural merge sort: existing ascending runs are kept, strictly
+    // descending ones reversed, and runs shorter than kMinNaturalRun are
+    // extended and sorted as usual. Runs are then merged pairwise, skipping
+    // merges whose halves are already in order, so sorted and nearly sorted
+    // input costs close to one pass.
+    static constexpr int kMinNaturalRun = 32;
+
+    static void sortNatural(int* arr, int size, SortScratch& scratch) {
+        if (size <= 1) return;
+        // Every run but the last has at least kMinNaturalRun elements, so
+        // the run starts plus the closing `size` fit behind the merge buffer.
+        int* buffer = scratch.acquire(size + size / kMinNaturalRun + 2);
+        int* runStarts = buffer + size;
+        int runs = 0;
+        int start = 0;
+        while (start < size) {
+            int end = start + 1;
+            if (end < size && arr[end] < arr[start]) {
+                while (end < size && arr[end] < arr[end - 1]) end++;
+                std::reverse(arr + start, arr + end);
+            } else {
+                while (end < size && arr[end] >= arr[end - 1]) end++;
+            }
+            if (end - start < kMinNaturalRun && end < size) {
+                end = std::min(start + kMinNaturalRun, size);
+                mergeSortRecursive(arr, start, end - 1, buffer, 1);
+            }
+            runStarts[runs++] = start;
+            start = end;
+        }
+        runStarts[runs] = size;
+
+        while (runs > 1) {
+            int kept = 0;
+            for (int r = 0; r < runs; r += 2) {
+                runStarts[kept++] = runStarts[r];
+                if (r + 1 >= runs) break;
+                int left = runStarts[r];
+                int mid = runStarts[r + 1] - 1;
+                int right = runStarts[r + 2] - 1;
+                if (arr[mid] > arr[mid + 1]) {
+                    merge(arr, left, mid, right, buffer);
+                }
+            }
+            runStarts[kept] = size;
+            runs = kept;
+        }
     }
 };
 
@@ -273,4 +527,235 @@ void mergeSortVarSort4(int* arr, int size) {
 
 void mergeSortVarSort5(int* arr, int size) {
     MergeSortVarSort5::sort(arr, size);
+}
+
+void mergeSortClassic(int* arr, int size, SortScratch& scratch) {
+    MergeSortClassic::sort(arr, size, scratch);
+}
+
+void mergeSort3To8(int* arr, int size, SortScratch& scratch) {
+    MergeSort3To8::sort(arr, size, scratch);
+}
+
+void mergeSort3(int* arr, int size, SortScratch& scratch) {
+    MergeSort3::sort(arr, size, scratch);
+}
+
+void mergeSort3To4(int* arr, int size, SortScratch& scratch) {
+    MergeSort3To4::sort(arr, size, scratch);
+}
+
+void mergeSort3To5(int* arr, int size, SortScratch& scratch) {
+    MergeSort3To5::sort(arr, size, scratch);
+}
+
+void mergeSortEven(int* arr, int size, SortScratch& scratch) {
+    MergeSortEven::sort(arr, size, scratch);
+}
+
+void mergeSortOdd(int* arr, int size, SortScratch& scratch) {
+    MergeSortOdd::sort(arr, size, scratch);
+}
+
+void mergeSortPowerOf2(int* arr, int size, SortScratch& scratch) {
+    MergeSortPowerOf2::sort(arr, size, scratch);
+}
+
+void mergeSortVarSort3(int* arr, int size, SortScratch& scratch) {
+    MergeSortVarSort3::sort(arr, size, scratch);
+}
+
+void mergeSortVarSort4(int* arr, int size, SortScratch& scratch) {
+    MergeSortVarSort4::sort(arr, size, scratch);
+}
+
+void mergeSortVarSort5(int* arr, int size, SortScratch& scratch) {
+    MergeSortVarSort5::sort(arr, size, scratch);
+}
+
+void mergeSortInPlaceClassic(int* arr, int size) {
+    MergeSortClassic::sortInPlace(arr, size);
+}
+
+void mergeSortInPlace3To8(int* arr, int size) {
+    MergeSort3To8::sortInPlace(arr, size);
+}
+
+void mergeSortInPlace3(int* arr, int size) {
+    MergeSort3::sortInPlace(arr, size);
+}
+
+void mergeSortInPlace3To4(int* arr, int size) {
+    MergeSort3To4::sortInPlace(arr, size);
+}
+
+void mergeSortInPlace3To5(int* arr, int size) {
+    MergeSort3To5::sortInPlace(arr, size);
+}
+
+void mergeSortInPlaceEven(int* arr, int size) {
+    MergeSortEven::sortInPlace(arr, size);
+}
+
+void mergeSortInPlaceOdd(int* arr, int size) {
+    MergeSortOdd::sortInPlace(arr, size);
+}
+
+void mergeSortInPlacePowerOf2(int* arr, int size) {
+    MergeSortPowerOf2::sortInPlace(arr, size);
+}
+
+void mergeSortInPlaceVarSort3(int* arr, int size) {
+    MergeSortVarSort3::sortInPlace(arr, size);
+}
+
+void mergeSortInPlaceVarSort4(int* arr, int size) {
+    MergeSortVarSort4::sortInPlace(arr, size);
+}
+
+void mergeSortInPlaceVarSort5(int* arr, int size) {
+    MergeSortVarSort5::sortInPlace(arr, size);
+}
+
+int mergeSortUniqueClassic(int* arr, int size) {
+    SortScratch scratch;
+    return MergeSortClassic::sortUnique(arr, size, scratch);
+}
+
+int mergeSortUnique3To8(int* arr, int size) {
+    SortScratch scratch;
+    return MergeSort3To8::sortUnique(arr, size, scratch);
+}
+
+int mergeSortUnique3(int* arr, int size) {
+    SortScratch scratch;
+    return MergeSort3::sortUnique(arr, size, scratch);
+}
+
+int mergeSortUnique3To4(int* arr, int size) {
+    SortScratch scratch;
+    return MergeSort3To4::sortUnique(arr, size, scratch);
+}
+
+int mergeSortUnique3To5(int* arr, int size) {
+    SortScratch scratch;
+    return MergeSort3To5::sortUnique(arr, size, scratch);
+}
+
+int mergeSortUniqueEven(int* arr, int size) {
+    SortScratch scratch;
+    return MergeSortEven::sortUnique(arr, size, scratch);
+}
+
+int mergeSortUniqueOdd(int* arr, int size) {
+    SortScratch scratch;
+    return MergeSortOdd::sortUnique(arr, size, scratch);
+}
+
+int mergeSortUniquePowerOf2(int* arr, int size) {
+    SortScratch scratch;
+    return MergeSortPowerOf2::sortUnique(arr, size, scratch);
+}
+
+int mergeSortUniqueVarSort3(int* arr, int size) {
+    SortScratch scratch;
+    return MergeSortVarSort3::sortUnique(arr, size, scratch);
+}
+
+int mergeSortUniqueVarSort4(int* arr, int size) {
+    SortScratch scratch;
+    return MergeSortVarSort4::sortUnique(arr, size, scratch);
+}
+
+int mergeSortUniqueVarSort5(int* arr, int size) {
+    SortScratch scratch;
+    return MergeSortVarSort5::sortUnique(arr, size, scratch);
+}
+
+int mergeSortUniqueClassic(int* arr, int size, SortScratch& scratch) {
+    return MergeSortClassic::sortUnique(arr, size, scratch);
+}
+
+int mergeSortUnique3To8(int* arr, int size, SortScratch& scratch) {
+    return MergeSort3To8::sortUnique(arr, size, scratch);
+}
+
+int mergeSortUnique3(int* arr, int size, SortScratch& scratch) {
+    return MergeSort3::sortUnique(arr, size, scratch);
+}
+
+int mergeSortUnique3To4(int* arr, int size, SortScratch& scratch) {
+    return MergeSort3To4::sortUnique(arr, size, scratch);
+}
+
+int mergeSortUnique3To5(int* arr, int size, SortScratch& scratch) {
+    return MergeSort3To5::sortUnique(arr, size, scratch);
+}
+
+int mergeSortUniqueEven(int* arr, int size, SortScratch& scratch) {
+    return MergeSortEven::sortUnique(arr, size, scratch);
+}
+
+int mergeSortUniqueOdd(int* arr, int size, SortScratch& scratch) {
+    return MergeSortOdd::sortUnique(arr, size, scratch);
+}
+
+int mergeSortUniquePowerOf2(int* arr, int size, SortScratch& scratch) {
+    return MergeSortPowerOf2::sortUnique(arr, size, scratch);
+}
+
+int mergeSortUniqueVarSort3(int* arr, int size, SortScratch& scratch) {
+    return MergeSortVarSort3::sortUnique(arr, size, scratch);
+}
+
+int mergeSortUniqueVarSort4(int* arr, int size, SortScratch& scratch) {
+    return MergeSortVarSort4::sortUnique(arr, size, scratch);
+}
+
+int mergeSortUniqueVarSort5(int* arr, int size, SortScratch& scratch) {
+    return MergeSortVarSort5::sortUnique(arr, size, scratch);
+}
+
+void mergeSort3To8CacheAware(int* arr, int size) {
+    SortScratch scratch;
+    MergeSort3To8::sortCacheAware(arr, size, scratch);
+}
+
+void mergeSort3To8CacheAware(int* arr, int size, SortScratch& scratch) {
+    MergeSort3To8::sortCacheAware(arr, size, scratch);
+}
+
+void mergeSort3To8Tiled(int* arr, int size, int tileSize, int ways, SortScratch& scratch) {
+    MergeSort3To8::sortTiled(arr, size, tileSize, ways, scratch);
+}
+
+void mergeSort3To8Prefetch(int* arr, int size, int prefetchDistance) {
+    SortScratch scratch;
+    mergeSort3To8Prefetch(arr, size, prefetchDistance, scratch);
+}
+
+void mergeSort3To8Prefetch(int* arr, int size, int prefetchDistance, SortScratch& scratch) {
+    MergeTuning tuning;
+    tuning.prefetchDistance = prefetchDistance;
+    MergeSort3To8::sort(arr, size, scratch, tuning);
+}
+
+void mergeSortNatural3To8(int* arr, int size) {
+    SortScratch scratch;
+    MergeSort3To8::sortNatural(arr, size, scratch);
+}
+
+void mergeSortNatural3To8(int* arr, int size, SortScratch& scratch) {
+    MergeSort3To8::sortNatural(arr, size, scratch);
+}
+
+void mergeSort3To8Streaming(int* arr, int size) {
+    SortScratch scratch;
+    mergeSort3To8Streaming(arr, size, detectCacheSizes().l3, scratch);
+}
+
+void mergeSort3To8Streaming(int* arr, int size, size_t thresholdBytes, SortScratch& scratch) {
+    MergeTuning tuning;
+    tuning.streamingThresholdBytes = thresholdBytes;
+    MergeSort3To8::sort(arr, size, scratch, tuning);
 }
\ No newline at end of file
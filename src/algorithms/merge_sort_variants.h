@@ -1,6 +1,8 @@
 #ifndef MERGE_SORT_VARIANTS_H_
 #define MERGE_SORT_VARIANTS_H_
 
+#include "sort_scratch.h"
+
 void mergeSortClassic(int* arr, int size);
 
 void mergeSort3To8(int* arr, int size);
@@ -15,6 +17,99 @@ void mergeSortVarSort3(int* arr, int size);
 void mergeSortVarSort4(int* arr, int size);
 void mergeSortVarSort5(int* arr, int size);
 
+// Overloads taking a SortScratch draw their buffer from it instead of the
+// heap; reusing one scratch across calls makes repeated sorts allocation-free.
+void mergeSortClassic(int* arr, int size, SortScratch& scratch);
+
+void mergeSort3To8(int* arr, int size, SortScratch& scratch);
+void mergeSort3(int* arr, int size, SortScratch& scratch);
+void mergeSort3To4(int* arr, int size, SortScratch& scratch);
+void mergeSort3To5(int* arr, int size, SortScratch& scratch);
+void mergeSortEven(int* arr, int size, SortScratch& scratch);
+void mergeSortOdd(int* arr, int size, SortScratch& scratch);
+void mergeSortPowerOf2(int* arr, int size, SortScratch& scratch);
+
+void mergeSortVarSort3(int* arr, int size, SortScratch& scratch);
+void mergeSortVarSort4(int* arr, int size, SortScratch& scratch);
+void mergeSortVarSort5(int* arr, int size, SortScratch& scratch);
+
+// In-place variants: stable merges by rotation (see mergeInPlace) instead of
+// a scratch buffer. No heap memory; O(n log^2 n) element moves.
+void mergeSortInPlaceClassic(int* arr, int size);
+
+void mergeSortInPlace3To8(int* arr, int size);
+void mergeSortInPlace3(int* arr, int size);
+void mergeSortInPlace3To4(int* arr, int size);
+void mergeSortInPlace3To5(int* arr, int size);
+void mergeSortInPlaceEven(int* arr, int size);
+void mergeSortInPlaceOdd(int* arr, int size);
+void mergeSortInPlacePowerOf2(int* arr, int size);
+
+void mergeSortInPlaceVarSort3(int* arr, int size);
+void mergeSortInPlaceVarSort4(int* arr, int size);
+void mergeSortInPlaceVarSort5(int* arr, int size);
+
+// Fused sort + unique: duplicates are dropped at the leaves and in every
+// merge, so later merges only see distinct values. The distinct values end up
+// sorted in arr[0, n) and n is returned; arr[n, size) is left unspecified.
+int mergeSortUniqueClassic(int* arr, int size);
+
+int mergeSortUnique3To8(int* arr, int size);
+int mergeSortUnique3(int* arr, int size);
+int mergeSortUnique3To4(int* arr, int size);
+int mergeSortUnique3To5(int* arr, int size);
+int mergeSortUniqueEven(int* arr, int size);
+int mergeSortUniqueOdd(int* arr, int size);
+int mergeSortUniquePowerOf2(int* arr, int size);
+
+int mergeSortUniqueVarSort3(int* arr, int size);
+int mergeSortUniqueVarSort4(int* arr, int size);
+int mergeSortUniqueVarSort5(int* arr, int size);
+
+int mergeSortUniqueClassic(int* arr, int size, SortScratch& scratch);
+
+int mergeSortUnique3To8(int* arr, int size, SortScratch& scratch);
+int mergeSortUnique3(int* arr, int size, SortScratch& scratch);
+int mergeSortUnique3To4(int* arr, int size, SortScratch& scratch);
+int mergeSortUnique3To5(int* arr, int size, SortScratch& scratch);
+int mergeSortUniqueEven(int* arr, int size, SortScratch& scratch);
+int mergeSortUniqueOdd(int* arr, int size, SortScratch& scratch);
+int mergeSortUniquePowerOf2(int* arr, int size, SortScratch& scratch);
+
+int mergeSortUniqueVarSort3(int* arr, int size, SortScratch& scratch);
+int mergeSortUniqueVarSort4(int* arr, int size, SortScratch& scratch);
+int mergeSortUniqueVarSort5(int* arr, int size, SortScratch& scratch);
+
+// Cache-aware 3-8 network merge sort: sorts L2-sized tiles in cache, then
+// combines them with wide multiway merges so large inputs stream through
+// DRAM only a few times. Tile size and fan-in come from detectCacheSizes();
+// the Tiled form takes them explicitly.
+void mergeSort3To8CacheAware(int* arr, int size);
+void mergeSort3To8CacheAware(int* arr, int size, SortScratch& scratch);
+void mergeSort3To8Tiled(int* arr, int size, int tileSize, int ways, SortScratch& scratch);
+
+// 3-8 network merge sort whose large merges issue software prefetches
+// `prefetchDistance` elements ahead on each stream (see prefetch.h).
+void mergeSort3To8Prefetch(int* arr, int size, int prefetchDistance);
+void mergeSort3To8Prefetch(int* arr, int size, int prefetchDistance, SortScratch& scratch);
+
+// Run-adaptive 3-8 network merge sort: keeps existing runs (reversing
+// descending ones) and only merges where they are out of order, so sorted
+// and nearly sorted input takes close to linear time.
+void mergeSortNatural3To8(int* arr, int size);
+void mergeSortNatural3To8(int* arr, int size, SortScratch& scratch);
+
+// 3-8 network merge sort whose merges with outputs larger than
+// `thresholdBytes` (the detected LLC size by default) write with
+// non-temporal stores.
+void mergeSort3To8Streaming(int* arr, int size);
+void mergeSort3To8Streaming(int* arr, int size, size_t thresholdBytes, SortScratch& scratch);
+
 void merge(int* arr, int left, int mid, int right);
+// `buffer` must hold at least mid - left + 1 ints.
+void merge(int* arr, int left, int mid, int right, int* buffer, int prefetchDistance = 0);
+// Stable merge of [left, mid] and [mid + 1, right] using only a fixed stack
+// cache and O(log n) recursion.
+void mergeInPlace(int* arr, int left, int mid, int right);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,23 @@
+#ifndef PREFETCH_H_
+#define PREFETCH_H_
+
+// Software prefetching for the streaming loops in merge() and
+// hoarePartition(). Distances are in elements; 0 disables prefetching. There
+// is no default distance: callers pick one calibrated for their machine
+// (see BM_PrefetchDistance). Ranges smaller than kPrefetchMinElements are
+// left to the hardware prefetcher since they are mostly cache resident
+// anyway.
+const int kPrefetchMinElements = 1 << 16;
+
+// One prefetch per 64-byte line of ints.
+const int kPrefetchStride = 16;
+
+inline void prefetchRead(const int* address) {
+    __builtin_prefetch(address, 0, 3);
+}
+
+inline void prefetchWrite(int* address) {
+    __builtin_prefetch(address, 1, 3);
+}
+
+#endif
@@ -1,32 +1,125 @@
 #include "quick_sort_variants.h"
+#include "sort_configs.h"
 #include "sorting_networks.h"
+#include "sort_stats.h"
+#include "prefetch.h"
 #include <vector>
 #include <algorithm>
-#include <random>
+#include <atomic>
+#include <cstdint>
 
 namespace pivot_strategies {
     int getLast(int* arr, int low, int high) {
         return high;
     }
     
+    // xorshift64* with one state per thread, so concurrent sorts neither
+    // race on nor contend for a shared generator. Each thread's seed comes
+    // from a global counter passed through splitmix64.
+    static uint64_t nextRandom() {
+        static std::atomic<uint64_t> seeds{0};
+        thread_local uint64_t state = [] {
+            uint64_t z = seeds.fetch_add(1, std::memory_order_relaxed) * 0x9E3779B97F4A7C15ULL + 0x9E3779B97F4A7C15ULL;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return (z ^ (z >> 31)) | 1;
+        }();
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545F4914F6CDD1DULL;
+    }
+
+    // Multiply-shift maps the top 32 random bits onto [low, high] without a
+    // division.
     int getRandom(int* arr, int low, int high) {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        std::uniform_int_distribution<> dis(low, high);
-        return dis(gen);
+        uint64_t span = static_cast<uint64_t>(high - low) + 1;
+        return low + static_cast<int>(((nextRandom() >> 32) * span) >> 32);
     }
     
+    static void compareAndSwap(int* arr, int a, int b) {
+        sort_stats::countComparison();
+        if (arr[a] > arr[b]) {
+            std::swap(arr[a], arr[b]);
+            sort_stats::countSwap();
+        }
+    }
+
     int getMedianOfThree(int* arr, int low, int high) {
         int mid = low + (high - low) / 2;
-        if (arr[low] > arr[mid]) std::swap(arr[low], arr[mid]);
-        if (arr[mid] > arr[high]) std::swap(arr[mid], arr[high]);
-        if (arr[low] > arr[mid]) std::swap(arr[low], arr[mid]);
+        compareAndSwap(arr, low, mid);
+        compareAndSwap(arr, mid, high);
+        compareAndSwap(arr, low, mid);
         return mid;
     }
+
+    // Sampled pivots: the sample is gathered into a small buffer, sorted with
+    // an AlphaDev network and written back to the same positions, so the
+    // median ends up at the middle sample position like in median-of-three.
+    const int kNintherThreshold = 128;
+    const int kPseudoMedianOf25Threshold = 1024;
+
+    static void sortSample5(int* arr, const int* positions) {
+        int buffer[5];
+        for (int k = 0; k < 5; k++) buffer[k] = arr[positions[k]];
+        Sort5AlphaDev(buffer);
+        for (int k = 0; k < 5; k++) arr[positions[k]] = buffer[k];
+    }
+
+    static void sortSample3(int* arr, int a, int b, int c) {
+        int buffer[3] = {arr[a], arr[b], arr[c]};
+        Sort3AlphaDev(buffer);
+        arr[a] = buffer[0];
+        arr[b] = buffer[1];
+        arr[c] = buffer[2];
+    }
+
+    int getMedianOfFive(int* arr, int low, int high) {
+        if (high - low < 7) return getMedianOfThree(arr, low, high);
+        int step = (high - low) / 4;
+        int positions[5] = {low, low + step, low + 2 * step, high - step, high};
+        sortSample5(arr, positions);
+        return positions[2];
+    }
+
+    int getNinther(int* arr, int low, int high) {
+        if (high - low + 1 < kNintherThreshold) return getMedianOfThree(arr, low, high);
+        int step = (high - low) / 8;
+        int p[9];
+        for (int k = 0; k < 9; k++) p[k] = low + k * step;
+        sortSample3(arr, p[0], p[1], p[2]);
+        sortSample3(arr, p[3], p[4], p[5]);
+        sortSample3(arr, p[6], p[7], p[8]);
+        sortSample3(arr, p[1], p[4], p[7]);
+        return p[4];
+    }
+
+    int getPseudoMedianOf25(int* arr, int low, int high) {
+        if (high - low + 1 < kPseudoMedianOf25Threshold) return getNinther(arr, low, high);
+        int step = (high - low) / 24;
+        int p[25];
+        for (int k = 0; k < 25; k++) p[k] = low + k * step;
+        for (int group = 0; group < 5; group++) sortSample5(arr, p + 5 * group);
+        int medians[5] = {p[2], p[7], p[12], p[17], p[22]};
+        sortSample5(arr, medians);
+        return medians[2];
+    }
 }
 
+// Ranges still to be sorted after a partition: [low, leftEnd] and
+// [rightStart, high]. Everything in the first is <= everything in the second,
+// and whatever lies between them is already in its final place.
+struct PartitionBounds {
+    int leftEnd;
+    int rightStart;
+};
+
 namespace partition_schemes {
-    int hoarePartition(int* arr, int low, int high, int pivotIndex) {
+    // With Prefetch, the ascending i scan and the descending j scan each
+    // request the line `distance` elements further along as they cross a
+    // cache line; the descending one is what the hardware handles worst.
+    template<bool Prefetch>
+    static int hoareScan(int* arr, int low, int high, int pivotIndex, int distance) {
         int pivot = arr[pivotIndex];
         int i = low - 1;
         int j = high + 1;
@@ -34,191 +127,207 @@ namespace partition_schemes {
         while (true) {
             do {
                 i++;
+                if (Prefetch && i % kPrefetchStride == 0) prefetchWrite(arr + std::min(i + distance, high));
+                sort_stats::countComparison();
             } while (arr[i] < pivot);
             
             do {
                 j--;
+                if (Prefetch && j % kPrefetchStride == 0) prefetchWrite(arr + std::max(j - distance, low));
+                sort_stats::countComparison();
             } while (arr[j] > pivot);
             
-            if (i >= j) return j;
+            if (i >= j) {
+                sort_stats::recordPartition(j - low + 1, high - low + 1);
+                return j;
+            }
             std::swap(arr[i], arr[j]);
+            sort_stats::countSwap();
         }
     }
-}
 
-namespace configs {
-    struct ClassicConfig {
-        static bool shouldUseNetwork(int size) {
-            return size <= 1;
+    PartitionBounds hoarePartition(int* arr, int low, int high, int pivotIndex, int prefetchDistance = 0) {
+        // With the pivot in the last slot the scan can stop at j == high and
+        // never shrink the range.
+        if (pivotIndex == high) {
+            std::swap(arr[low], arr[high]);
+            pivotIndex = low;
         }
-        
-        static void applySortingNetwork(int* arr, int size) {}
-    };
-
-    struct Current3To8Config {
-        static bool shouldUseNetwork(int size) {
-            return size <= 8 && size != 2;
-        }
-        
-        static void applySortingNetwork(int* arr, int size) {
-            switch(size) {
-                case 1: return;
-                case 3: Sort3AlphaDev(arr); return;
-                case 4: Sort4AlphaDev(arr); return;
-                case 5: Sort5AlphaDev(arr); return;
-                case 6: Sort6AlphaDev(arr); return;
-                case 7: Sort7AlphaDev(arr); return;
-                case 8: Sort8AlphaDev(arr); return;
-            }
-        }
-    };
-
-    struct Network3Config {
-        static bool shouldUseNetwork(int size) {
-            return size == 3;
+        int j;
+        if (prefetchDistance > 0 && high - low + 1 >= kPrefetchMinElements) {
+            j = hoareScan<true>(arr, low, high, pivotIndex, prefetchDistance);
+        } else {
+            j = hoareScan<false>(arr, low, high, pivotIndex, 0);
         }
-        
-        static void applySortingNetwork(int* arr, int size) {
-            if (size == 3) Sort3AlphaDev(arr);
-        }
-    };
-
-    struct Networks3To4Config {
-        static bool shouldUseNetwork(int size) {
-            return size <= 4 && size != 2;
-        }
-        
-        static void applySortingNetwork(int* arr, int size) {
-            switch(size) {
-                case 1: return;
-                case 3: Sort3AlphaDev(arr); return;
-                case 4: Sort4AlphaDev(arr); return;
-            }
-        }
-    };
-
-    struct Networks3To5Config {
-        static bool shouldUseNetwork(int size) {
-            return size <= 5 && size != 2;
-        }
-        
-        static void applySortingNetwork(int* arr, int size) {
-            switch(size) {
-                case 1: return;
-                case 3: Sort3AlphaDev(arr); return;
-                case 4: Sort4AlphaDev(arr); return;
-                case 5: Sort5AlphaDev(arr); return;
-            }
-        }
-    };
+        return {j, j + 1};
+    }
 
-    struct NetworksEvenConfig {
-        static bool shouldUseNetwork(int size) {
-            return size == 4 || size == 6 || size == 8;
+    // Moves every element for which isLeft holds to the front of
+    // [first, last] and returns the end of that group. Each step swaps
+    // unconditionally and advances the boundary by the comparison result, so
+    // the loop has no data-dependent branch.
+    template<typename IsLeft>
+    static int branchlessScan(int* arr, int first, int last, IsLeft isLeft) {
+        for (int i = first; i <= last; i++) {
+            int value = arr[i];
+            sort_stats::countComparison();
+            arr[i] = arr[first];
+            arr[first] = value;
+            first += isLeft(value);
         }
-        
-        static void applySortingNetwork(int* arr, int size) {
-            switch(size) {
-                case 4: Sort4AlphaDev(arr); return;
-                case 6: Sort6AlphaDev(arr); return;
-                case 8: Sort8AlphaDev(arr); return;
-            }
-        }
-    };
+        return first;
+    }
 
-    struct NetworksOddConfig {
-        static bool shouldUseNetwork(int size) {
-            return size < 8 && size % 2 != 0;
-        }
-        
-        static void applySortingNetwork(int* arr, int size) {
-            switch(size) {
-                case 3: Sort3AlphaDev(arr); return;
-                case 5: Sort5AlphaDev(arr); return;
-                case 7: Sort7AlphaDev(arr); return;
-            }
-        }
-    };
+    // Lomuto keeps the larger elements in nearly their original order, so a
+    // patterned input (organ pipe, for one) can hand the same bad pivot
+    // sample to every level. After a split worse than 1:7 both sides get
+    // their ends swapped with elements a quarter of the way in, as pdqsort
+    // does, which moves new values under the low/mid/high samples.
+    const int kPatternBreakMinSize = 16;
 
-    struct NetworksPowerOf2Config {
-        static bool shouldUseNetwork(int size) {
-            return size == 4 || size == 8;
-        }
-        
-        static void applySortingNetwork(int* arr, int size) {
-            switch(size) {
-                case 4: Sort4AlphaDev(arr); return;
-                case 8: Sort8AlphaDev(arr); return;
-            }
-        }
-    };
+    static void breakPatterns(int* arr, int low, int high) {
+        int size = high - low + 1;
+        if (size < kPatternBreakMinSize) return;
+        int quarter = size / 4;
+        std::swap(arr[low], arr[low + quarter]);
+        std::swap(arr[high], arr[high - quarter]);
+        std::swap(arr[low + 1], arr[low + quarter + 1]);
+        std::swap(arr[high - 1], arr[high - quarter - 1]);
+    }
 
-    struct VarSort3Config {
-        static bool shouldUseNetwork(int size) {
-            return size <= 3;
-        }
-        
-        static void applySortingNetwork(int* arr, int size) {
-            std::vector<int> newArr(size + 1);
-            newArr[0] = size; 
-            std::copy(arr, arr + size, newArr.begin() + 1);
-            VarSort3AlphaDev(newArr.data());
-            std::copy(newArr.begin() + 1, newArr.end(), arr);
+    // Branchless Lomuto: the pivot is parked at low, smaller elements are
+    // gathered behind it and the pivot is swapped into place. If nothing is
+    // smaller the pivot is the minimum, so a second pass gathers the
+    // elements equal to it, which are then done; this keeps runs of
+    // duplicates from going quadratic.
+    PartitionBounds branchlessLomutoPartition(int* arr, int low, int high, int pivotIndex, int) {
+        std::swap(arr[low], arr[pivotIndex]);
+        int pivot = arr[low];
+        int p = branchlessScan(arr, low + 1, high, [pivot](int value) { return value < pivot; }) - 1;
+        PartitionBounds bounds = {p - 1, p + 1};
+        if (p == low) {
+            p = branchlessScan(arr, low + 1, high, [pivot](int value) { return value <= pivot; }) - 1;
+            bounds = {low - 1, p + 1};
         }
-    };
+        std::swap(arr[low], arr[p]);
+        sort_stats::countSwap();
+        sort_stats::recordPartition(bounds.leftEnd - low + 1, high - low + 1);
 
-    struct VarSort4Config {
-        static bool shouldUseNetwork(int size) {
-            return size <= 4;
+        int smaller = std::min(bounds.leftEnd - low, high - bounds.rightStart) + 1;
+        if (smaller < (high - low + 1) / 8) {
+            breakPatterns(arr, low, bounds.leftEnd);
+            breakPatterns(arr, bounds.rightStart, high);
         }
-        
-        static void applySortingNetwork(int* arr, int size) {
-            std::vector<int> newArr(size + 1);
-            newArr[0] = size;
-            std::copy(arr, arr + size, newArr.begin() + 1);
-            VarSort4AlphaDev(newArr.data());
-            std::copy(newArr.begin() + 1, newArr.end(), arr);
-        }
-    };
+        return bounds;
+    }
 
-    struct VarSort5Config {
-        static bool shouldUseNetwork(int size) {
-            return size <= 5;
-        }
-        
-        static void applySortingNetwork(int* arr, int size) {
-            std::vector<int> newArr(size + 1);
-            newArr[0] = size;
-            std::copy(arr, arr + size, newArr.begin() + 1);
-            VarSort5AlphaDev(newArr.data());
-            std::copy(newArr.begin() + 1, newArr.end(), arr);
+    // Bentley-McIlroy three-way partition: a Hoare scan that parks keys
+    // equal to the pivot at both ends and swaps them into the middle at the
+    // end. Afterwards [low, lt) < pivot, [lt, gt] == pivot and
+    // (gt, high] > pivot, so equal keys are never touched again. Distinct
+    // keys are scanned exactly as by hoarePartition.
+    PartitionBounds threeWayPartition(int* arr, int low, int high, int pivotIndex, int) {
+        std::swap(arr[pivotIndex], arr[high]);
+        int pivot = arr[high];
+        int i = low - 1, j = high;
+        int p = low - 1, q = high;
+        while (true) {
+            do {
+                i++;
+                sort_stats::countComparison();
+            } while (arr[i] < pivot);
+            do {
+                j--;
+                sort_stats::countComparison();
+            } while (j > low && pivot < arr[j]);
+            if (i >= j) break;
+            std::swap(arr[i], arr[j]);
+            sort_stats::countSwap();
+            if (arr[i] == pivot) std::swap(arr[++p], arr[i]);
+            if (arr[j] == pivot) std::swap(arr[--q], arr[j]);
         }
-    };
+        std::swap(arr[i], arr[high]);
+        int lt = i;
+        int gt = i;
+        for (int k = low; k <= p; k++) std::swap(arr[k], arr[--lt]);
+        for (int k = high - 1; k >= q; k--) std::swap(arr[k], arr[++gt]);
+        sort_stats::recordPartition(lt - low, high - low + 1);
+        return {lt - 1, gt + 1};
+    }
 }
 
-template<typename Config>
+template<typename Config, int (*PivotStrategy)(int*, int, int) = pivot_strategies::getMedianOfThree,
+         PartitionBounds (*Partition)(int*, int, int, int, int) = partition_schemes::hoarePartition>
 class QuickSortVariant {
 private:
-    static void quickSortRecursive(int* arr, int low, int high) {
+    static int quickSortRecursive(int* arr, int low, int high, int depth, int prefetchDistance = 0) {
         int size = high - low + 1;
+        sort_stats::recordDepth(depth);
         
         if (Config::shouldUseNetwork(size)) {
+            sort_stats::countLeaf(size);
             Config::applySortingNetwork(arr + low, size);
-            return;
+            return depth;
         }
         
         if (low < high) {
-            int pivotIndex = pivot_strategies::getMedianOfThree(arr, low, high);
-            int pi = partition_schemes::hoarePartition(arr, low, high, pivotIndex);
+            int pivotIndex = PivotStrategy(arr, low, high);
+            PartitionBounds bounds = Partition(arr, low, high, pivotIndex, prefetchDistance);
             
-            quickSortRecursive(arr, low, pi);
-            quickSortRecursive(arr, pi + 1, high);
+            int leftDepth = quickSortRecursive(arr, low, bounds.leftEnd, depth + 1, prefetchDistance);
+            int rightDepth = quickSortRecursive(arr, bounds.rightStart, high, depth + 1, prefetchDistance);
+            return std::max(leftDepth, rightDepth);
         }
+        return depth;
     }
 
 public:
-    static void sort(int* arr, int size) {
-        quickSortRecursive(arr, 0, size - 1);
+    static void sort(int* arr, int size, int prefetchDistance = 0) {
+        quickSortRecursive(arr, 0, size - 1, 0, prefetchDistance);
+    }
+
+    static int sortReportingDepth(int* arr, int size) {
+        return quickSortRecursive(arr, 0, size - 1, 0);
+    }
+
+    // Quickselect: partitions only the side holding position n until the
+    // remaining range is small enough for a network.
+    static void select(int* arr, int size, int n) {
+        int low = 0, high = size - 1;
+        while (low < high) {
+            int rangeSize = high - low + 1;
+            if (Config::shouldUseNetwork(rangeSize)) {
+                sort_stats::countLeaf(rangeSize);
+                Config::applySortingNetwork(arr + low, rangeSize);
+                return;
+            }
+            int pivotIndex = PivotStrategy(arr, low, high);
+            PartitionBounds bounds = Partition(arr, low, high, pivotIndex, 0);
+            if (n <= bounds.leftEnd) {
+                high = bounds.leftEnd;
+            } else if (n >= bounds.rightStart) {
+                low = bounds.rightStart;
+            } else {
+                return;
+            }
+        }
+    }
+
+    // Quicksort that skips every partition lying entirely at or after k.
+    static void partialSort(int* arr, int low, int high, int k) {
+        while (low < high) {
+            int rangeSize = high - low + 1;
+            if (Config::shouldUseNetwork(rangeSize)) {
+                sort_stats::countLeaf(rangeSize);
+                Config::applySortingNetwork(arr + low, rangeSize);
+                return;
+            }
+            int pivotIndex = PivotStrategy(arr, low, high);
+            PartitionBounds bounds = Partition(arr, low, high, pivotIndex, 0);
+            partialSort(arr, low, bounds.leftEnd, k);
+            if (bounds.rightStart >= k) return;
+            low = bounds.rightStart;
+        }
     }
 };
 
@@ -234,6 +343,12 @@ using QuickSortVarSort3 = QuickSortVariant<configs::VarSort3Config>;
 using QuickSortVarSort4 = QuickSortVariant<configs::VarSort4Config>;
 using QuickSortVarSort5 = QuickSortVariant<configs::VarSort5Config>;
 
+using QuickSort3To8MedianOf5 = QuickSortVariant<configs::Current3To8Config, pivot_strategies::getMedianOfFive>;
+using QuickSort3To8Ninther = QuickSortVariant<configs::Current3To8Config, pivot_strategies::getNinther>;
+using QuickSort3To8PseudoMedianOf25 = QuickSortVariant<configs::Current3To8Config, pivot_strategies::getPseudoMedianOf25>;
+using QuickSort3To8ThreeWay = QuickSortVariant<configs::Current3To8Config, pivot_strategies::getMedianOfThree,
+                                               partition_schemes::threeWayPartition>;
+
 void quickSortClassic(int* arr, int size) {
     QuickSortClassic::sort(arr, size);
 }
@@ -276,4 +391,69 @@ void quickSortVarSort4(int* arr, int size) {
 
 void quickSortVarSort5(int* arr, int size) {
     QuickSortVarSort5::sort(arr, size);
-}
\ No newline at end of file
+}
+
+void quickSort3To8MedianOf5(int* arr, int size) {
+    QuickSort3To8MedianOf5::sort(arr, size);
+}
+
+void quickSort3To8Ninther(int* arr, int size) {
+    QuickSort3To8Ninther::sort(arr, size);
+}
+
+void quickSort3To8PseudoMedianOf25(int* arr, int size) {
+    QuickSort3To8PseudoMedianOf25::sort(arr, size);
+}
+
+void quickSort3To8ThreeWay(int* arr, int size) {
+    QuickSort3To8ThreeWay::sort(arr, size);
+}
+
+void quickSort3To8Prefetch(int* arr, int size, int prefetchDistance) {
+    QuickSort3To8::sort(arr, size, prefetchDistance);
+}
+
+template<int (*PivotStrategy)(int*, int, int)>
+static int sortReportingDepth(int* arr, int size, PartitionScheme partition) {
+    using namespace partition_schemes;
+    using Config = configs::Current3To8Config;
+    switch (partition) {
+        case PartitionScheme::BranchlessLomuto:
+            return QuickSortVariant<Config, PivotStrategy, branchlessLomutoPartition>::sortReportingDepth(arr, size);
+        case PartitionScheme::ThreeWay:
+            return QuickSortVariant<Config, PivotStrategy, threeWayPartition>::sortReportingDepth(arr, size);
+        default:
+            return QuickSortVariant<Config, PivotStrategy, hoarePartition>::sortReportingDepth(arr, size);
+    }
+}
+
+int quickSort3To8MaxDepth(int* arr, int size, PivotSelection pivot, PartitionScheme partition) {
+    using namespace pivot_strategies;
+    switch (pivot) {
+        case PivotSelection::MedianOf5: return sortReportingDepth<getMedianOfFive>(arr, size, partition);
+        case PivotSelection::Ninther: return sortReportingDepth<getNinther>(arr, size, partition);
+        case PivotSelection::PseudoMedianOf25: return sortReportingDepth<getPseudoMedianOf25>(arr, size, partition);
+        case PivotSelection::Random: return sortReportingDepth<getRandom>(arr, size, partition);
+        case PivotSelection::Last: return sortReportingDepth<getLast>(arr, size, partition);
+        default: return sortReportingDepth<getMedianOfThree>(arr, size, partition);
+    }
+}
+
+void quickSort3To8With(int* arr, int size, PivotSelection pivot, PartitionScheme partition) {
+    quickSort3To8MaxDepth(arr, size, pivot, partition);
+}
+
+void nthElement(int* arr, int size, int n) {
+    if (n < 0 || n >= size) return;
+    QuickSort3To8::select(arr, size, n);
+}
+
+void partialSort(int* arr, int size, int k) {
+    if (k <= 0 || size <= 1) return;
+    QuickSort3To8::partialSort(arr, 0, size - 1, std::min(k, size));
+}
+
+void topK(int* arr, int size, int k) {
+    if (k <= 0 || k >= size) return;
+    QuickSort3To8::select(arr, size, k - 1);
+}
@@ -15,4 +15,57 @@ void quickSortVarSort3(int* arr, int size);
 void quickSortVarSort4(int* arr, int size);
 void quickSortVarSort5(int* arr, int size);
 
+// Network-sampled pivot selection on top of the 3-8 network configuration.
+void quickSort3To8MedianOf5(int* arr, int size);
+void quickSort3To8Ninther(int* arr, int size);
+void quickSort3To8PseudoMedianOf25(int* arr, int size);
+
+// 3-8 network quick sort with a three-way (less / equal / greater) partition:
+// linear in n for each distinct key, for inputs dominated by duplicates.
+void quickSort3To8ThreeWay(int* arr, int size);
+
+// 3-8 network quick sort whose large partitions issue software prefetches
+// `prefetchDistance` elements ahead of both scans (see prefetch.h).
+void quickSort3To8Prefetch(int* arr, int size, int prefetchDistance);
+
+enum class PivotSelection {
+    MedianOfThree,
+    MedianOf5,
+    Ninther,
+    PseudoMedianOf25,
+    // Uniform over the range, from a per-thread xorshift generator.
+    Random,
+    // The last element; quadratic on sorted and other patterned input.
+    Last
+};
+
+enum class PartitionScheme {
+    Hoare,
+    // Lomuto with the element moves driven by the comparison result instead
+    // of a branch, plus a pass that retires runs equal to a minimum pivot
+    // and pdqsort-style pattern breaking after lopsided splits.
+    BranchlessLomuto,
+    // Bentley-McIlroy: keys equal to the pivot are excluded from recursion.
+    ThreeWay
+};
+
+// 3-8 network quick sort with any pivot selection / partition pairing.
+void quickSort3To8With(int* arr, int size, PivotSelection pivot, PartitionScheme partition);
+
+// Sorts like quickSort3To8With and returns the deepest recursion level
+// reached.
+int quickSort3To8MaxDepth(int* arr, int size, PivotSelection pivot,
+                          PartitionScheme partition = PartitionScheme::Hoare);
+
+// Selection on top of the 3-8 network quick sort (median-of-three pivots,
+// Hoare partition, networks for the final small ranges).
+// nthElement places the element of rank n at arr[n], with nothing larger
+// before it and nothing smaller after it.
+void nthElement(int* arr, int size, int n);
+// partialSort leaves the k smallest elements sorted in arr[0, k); the order
+// of the rest is unspecified.
+void partialSort(int* arr, int size, int k);
+// topK moves the k smallest elements into arr[0, k) in unspecified order.
+void topK(int* arr, int size, int k);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "segmented_sort.h"
+#include "cache_info.h"
+#include "merge_sort_variants.h"
+#include "quick_sort_variants.h"
+#include "sorting_networks.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace segmented {
+    const int kTinySegment = 8;
+
+    static void sortTiny(int* arr, int size) {
+        switch (size) {
+            case 2: if (arr[1] < arr[0]) std::swap(arr[0], arr[1]); return;
+            case 3: Sort3AlphaDev(arr); return;
+            case 4: Sort4AlphaDev(arr); return;
+            case 5: Sort5AlphaDev(arr); return;
+            case 6: Sort6AlphaDev(arr); return;
+            case 7: Sort7AlphaDev(arr); return;
+            case 8: Sort8AlphaDev(arr); return;
+        }
+    }
+
+    static int largeSegmentThreshold() {
+        return static_cast<int>(detectCacheSizes().l2 / sizeof(int));
+    }
+
+    static void sortSegment(int* arr, int size, SortScratch& scratch) {
+        if (size <= kTinySegment) {
+            sortTiny(arr, size);
+        } else if (size <= largeSegmentThreshold()) {
+            quickSort3To8(arr, size);
+        } else {
+            mergeSort3To8CacheAware(arr, size, scratch);
+        }
+    }
+
+    static double cost(int size) {
+        return size <= kTinySegment ? size : size * std::log2(static_cast<double>(size));
+    }
+
+    // What one worker sorts: a contiguous run of tiny segments, handled in a
+    // tight loop, plus a list of larger ones.
+    struct Assignment {
+        int tinyBegin = 0;
+        int tinyEnd = 0;
+        std::vector<int> segments;
+        double load = 0;
+    };
+
+    static void run(int* data, const int* offsets, const std::vector<int>& tiny, const Assignment& assignment) {
+        for (int t = assignment.tinyBegin; t < assignment.tinyEnd; t++) {
+            int s = tiny[t];
+            sortTiny(data + offsets[s], offsets[s + 1] - offsets[s]);
+        }
+        SortScratch scratch;
+        for (int s : assignment.segments) {
+            sortSegment(data + offsets[s], offsets[s + 1] - offsets[s], scratch);
+        }
+    }
+}
+
+void segmentedSort(int* data, const int* offsets, int segmentCount, int threads) {
+    if (threads <= 1) {
+        SortScratch scratch;
+        for (int s = 0; s < segmentCount; s++) {
+            segmented::sortSegment(data + offsets[s], offsets[s + 1] - offsets[s], scratch);
+        }
+        return;
+    }
+
+    std::vector<int> tiny;
+    std::vector<int> larger;
+    for (int s = 0; s < segmentCount; s++) {
+        int size = offsets[s + 1] - offsets[s];
+        if (size <= 1) continue;
+        (size <= segmented::kTinySegment ? tiny : larger).push_back(s);
+    }
+    std::sort(larger.begin(), larger.end(), [&](int a, int b) {
+        return offsets[a + 1] - offsets[a] > offsets[b + 1] - offsets[b];
+    });
+
+    std::vector<segmented::Assignment> assignments(threads);
+    int tinyCount = tiny.size();
+    for (int w = 0; w < threads; w++) {
+        segmented::Assignment& assignment = assignments[w];
+        assignment.tinyBegin = static_cast<long long>(tinyCount) * w / threads;
+        assignment.tinyEnd = static_cast<long long>(tinyCount) * (w + 1) / threads;
+        for (int t = assignment.tinyBegin; t < assignment.tinyEnd; t++) {
+            assignment.load += segmented::cost(offsets[tiny[t] + 1] - offsets[tiny[t]]);
+        }
+    }
+    for (int s : larger) {
+        auto lightest = std::min_element(assignments.begin(), assignments.end(),
+            [](const segmented::Assignment& a, const segmented::Assignment& b) { return a.load < b.load; });
+        lightest->segments.push_back(s);
+        lightest->load += segmented::cost(offsets[s + 1] - offsets[s]);
+    }
+
+    std::vector<std::thread> workers;
+    for (int w = 1; w < threads; w++) {
+        workers.emplace_back(segmented::run, data, offsets, std::cref(tiny), std::cref(assignments[w]));
+    }
+    segmented::run(data, offsets, tiny, assignments[0]);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
@@ -0,0 +1,12 @@
+#ifndef SEGMENTED_SORT_H_
+#define SEGMENTED_SORT_H_
+
+// Sorts each segment data[offsets[s], offsets[s + 1]) independently, for
+// s in [0, segmentCount); offsets must be non-decreasing. Segments are binned
+// by size: up to 8 elements go straight to the Sort3-8AlphaDev networks,
+// medium ones to quickSort3To8, and segments larger than L2 to the cache-aware
+// merge sort. With threads > 1 the segments are spread over worker threads by
+// estimated cost (n log n), largest first onto the least-loaded worker.
+void segmentedSort(int* data, const int* offsets, int segmentCount, int threads = 1);
+
+#endif
@@ -0,0 +1,163 @@
+#ifndef SORT_CONFIGS_H_
+#define SORT_CONFIGS_H_
+
+#include <algorithm>
+#include "sorting_networks.h"
+
+// Leaf policies shared by the merge and quick sort engines: which range sizes
+// are finished by a network instead of recursing, and the AlphaDev network
+// applied to them.
+namespace configs {
+    struct ClassicConfig {
+        static bool shouldUseNetwork(int size) {
+            return size <= 1;
+        }
+        
+        static void applySortingNetwork(int* arr, int size) {}
+    };
+
+    struct Current3To8Config {
+        static bool shouldUseNetwork(int size) {
+            return size <= 8 && size != 2;
+        }
+        
+        static void applySortingNetwork(int* arr, int size) {
+            switch(size) {
+                case 1: return;
+                case 3: Sort3AlphaDev(arr); return;
+                case 4: Sort4AlphaDev(arr); return;
+                case 5: Sort5AlphaDev(arr); return;
+                case 6: Sort6AlphaDev(arr); return;
+                case 7: Sort7AlphaDev(arr); return;
+                case 8: Sort8AlphaDev(arr); return;
+            }
+        }
+    };
+
+    struct Network3Config {
+        static bool shouldUseNetwork(int size) {
+            return size == 3;
+        }
+        
+        static void applySortingNetwork(int* arr, int size) {
+            switch(size) {
+                case 1: return;
+                case 3: Sort3AlphaDev(arr); return;
+            }
+        }
+    };
+
+    struct Networks3To4Config {
+        static bool shouldUseNetwork(int size) {
+            return size <= 4 && size != 2;
+        }
+        
+        static void applySortingNetwork(int* arr, int size) {
+            switch(size) {
+                case 1: return;
+                case 3: Sort3AlphaDev(arr); return;
+                case 4: Sort4AlphaDev(arr); return;
+            }
+        }
+    };
+
+    struct Networks3To5Config {
+        static bool shouldUseNetwork(int size) {
+            return size <= 5 && size != 2;
+        }
+        
+        static void applySortingNetwork(int* arr, int size) {
+            switch(size) {
+                case 1: return;
+                case 3: Sort3AlphaDev(arr); return;
+                case 4: Sort4AlphaDev(arr); return;
+                case 5: Sort5AlphaDev(arr); return;
+            }
+        }
+    };
+
+    struct NetworksEvenConfig {
+        static bool shouldUseNetwork(int size) {
+            return size == 4 || size == 6 || size == 8;
+        }
+        
+        static void applySortingNetwork(int* arr, int size) {
+            switch(size) {
+                case 4: Sort4AlphaDev(arr); return;
+                case 6: Sort6AlphaDev(arr); return;
+                case 8: Sort8AlphaDev(arr); return;
+            }
+        }
+    };
+
+    struct NetworksOddConfig {
+        static bool shouldUseNetwork(int size) {
+            return size < 8 && size % 2 != 0;
+        }
+        
+        static void applySortingNetwork(int* arr, int size) {
+            switch(size) {
+                case 3: Sort3AlphaDev(arr); return;
+                case 5: Sort5AlphaDev(arr); return;
+                case 7: Sort7AlphaDev(arr); return;
+            }
+        }
+    };
+
+    struct NetworksPowerOf2Config {
+        static bool shouldUseNetwork(int size) {
+            return size == 4 || size == 8;
+        }
+        
+        static void applySortingNetwork(int* arr, int size) {
+            switch(size) {
+                case 4: Sort4AlphaDev(arr); return;
+                case 8: Sort8AlphaDev(arr); return;
+            }
+        }
+    };
+
+    struct VarSort3Config {
+        static bool shouldUseNetwork(int size) {
+            return size <= 3;
+        }
+        
+        static void applySortingNetwork(int* arr, int size) {
+            int newArr[4];
+            newArr[0] = size;
+            std::copy(arr, arr + size, newArr + 1);
+            VarSort3AlphaDev(newArr);
+            std::copy(newArr + 1, newArr + size + 1, arr);
+        }
+    };
+
+    struct VarSort4Config {
+        static bool shouldUseNetwork(int size) {
+            return size <= 4;
+        }
+        
+        static void applySortingNetwork(int* arr, int size) {
+            int newArr[5];
+            newArr[0] = size;
+            std::copy(arr, arr + size, newArr + 1);
+            VarSort4AlphaDev(newArr);
+            std::copy(newArr + 1, newArr + size + 1, arr);
+        }
+    };
+
+    struct VarSort5Config {
+        static bool shouldUseNetwork(int size) {
+            return size <= 5;
+        }
+        
+        static void applySortingNetwork(int* arr, int size) {
+            int newArr[6];
+            newArr[0] = size;
+            std::copy(arr, arr + size, newArr + 1);
+            VarSort5AlphaDev(newArr);
+            std::copy(newArr + 1, newArr + size + 1, arr);
+        }
+    };
+}
+
+#endif
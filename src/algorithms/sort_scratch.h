@@ -0,0 +1,33 @@
+#ifndef SORT_SCRATCH_H_
+#define SORT_SCRATCH_H_
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+// Reusable scratch space for the merge-based sorts. Memory comes from the
+// given memory resource (for example a std::pmr::monotonic_buffer_resource
+// over a caller-owned arena) and is kept between sorts, so once the scratch
+// has grown to the largest size sorted, further sorts allocate nothing.
+class SortScratch {
+public:
+    explicit SortScratch(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : buffer_(resource) {}
+
+    // Returns room for at least `size` ints, growing the buffer if needed.
+    int* acquire(int size) {
+        if (static_cast<size_t>(size) > buffer_.size()) {
+            buffer_.resize(size);
+        }
+        return buffer_.data();
+    }
+
+    size_t capacityBytes() const {
+        return buffer_.capacity() * sizeof(int);
+    }
+
+private:
+    std::pmr::vector<int> buffer_;
+};
+
+#endif
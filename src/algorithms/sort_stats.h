@@ -0,0 +1,87 @@
+#ifndef SORT_STATS_H_
+#define SORT_STATS_H_
+
+#include <cstdint>
+
+// Per-thread counters describing how inputs flow through MergeSortVariant and
+// QuickSortVariant. Recording is compiled in only when SORT_STATS is defined
+// (bazel build --config=stats); otherwise every hook is an empty inline
+// function and snapshot() returns zeros.
+
+const int kMaxNetworkLeafSize = 8;
+const int kPartitionBalanceBuckets = 10;
+
+struct SortStats {
+    uint64_t comparisons = 0;
+    uint64_t swaps = 0;
+    // Leaves handed to Config::applySortingNetwork, indexed by leaf size.
+    uint64_t networkLeaves[kMaxNetworkLeafSize + 1] = {};
+    int maxRecursionDepth = 0;
+    // Share of the smaller side after each partition step, in 5% buckets
+    // from [0%, 5%) to [45%, 50%].
+    uint64_t partitionBalance[kPartitionBalanceBuckets] = {};
+    uint64_t mergeElementsMoved = 0;
+};
+
+namespace sort_stats {
+#ifdef SORT_STATS
+    const bool kEnabled = true;
+
+    inline SortStats& current() {
+        static thread_local SortStats stats;
+        return stats;
+    }
+
+    inline void countComparison() {
+        current().comparisons++;
+    }
+
+    inline void countSwap() {
+        current().swaps++;
+    }
+
+    inline void countLeaf(int size) {
+        if (size >= 0 && size <= kMaxNetworkLeafSize) current().networkLeaves[size]++;
+    }
+
+    inline void recordDepth(int depth) {
+        if (depth > current().maxRecursionDepth) current().maxRecursionDepth = depth;
+    }
+
+    inline void recordPartition(int leftSize, int totalSize) {
+        int smaller = leftSize < totalSize - leftSize ? leftSize : totalSize - leftSize;
+        int bucket = static_cast<int>(2LL * kPartitionBalanceBuckets * smaller / totalSize);
+        if (bucket >= kPartitionBalanceBuckets) bucket = kPartitionBalanceBuckets - 1;
+        current().partitionBalance[bucket]++;
+    }
+
+    inline void countMerged(int elements) {
+        current().mergeElementsMoved += elements;
+    }
+
+    inline SortStats snapshot() {
+        return current();
+    }
+
+    inline void reset() {
+        current() = SortStats();
+    }
+#else
+    const bool kEnabled = false;
+
+    inline void countComparison() {}
+    inline void countSwap() {}
+    inline void countLeaf(int) {}
+    inline void recordDepth(int) {}
+    inline void recordPartition(int, int) {}
+    inline void countMerged(int) {}
+
+    inline SortStats snapshot() {
+        return SortStats();
+    }
+
+    inline void reset() {}
+#endif
+}
+
+#endif
@@ -0,0 +1,37 @@
+#include "sorted_accumulator.h"
+#include "merge_sort_variants.h"
+
+void SortedAccumulator::append(const int* values, int count) {
+    if (count <= 0) return;
+    int start = size();
+    data_.insert(data_.end(), values, values + count);
+    mergeSort3To8(data_.data() + start, count, scratch_);
+    levelStarts_.push_back(start);
+
+    while (levelCount() >= 2) {
+        int last = levelStarts_[levelCount() - 1];
+        int previous = levelStarts_[levelCount() - 2];
+        if (last - previous > 2 * (size() - last)) break;
+        mergeLastLevels();
+    }
+}
+
+const std::vector<int>& SortedAccumulator::sorted() {
+    while (levelCount() >= 2) {
+        mergeLastLevels();
+    }
+    return data_;
+}
+
+void SortedAccumulator::clear() {
+    data_.clear();
+    levelStarts_.clear();
+}
+
+void SortedAccumulator::mergeLastLevels() {
+    int mid = levelStarts_.back() - 1;
+    levelStarts_.pop_back();
+    int left = levelStarts_.back();
+    int right = size() - 1;
+    merge(data_.data(), left, mid, right, scratch_.acquire(mid - left + 1));
+}
@@ -0,0 +1,40 @@
+#ifndef SORTED_ACCUMULATOR_H_
+#define SORTED_ACCUMULATOR_H_
+
+#include <vector>
+#include "sort_scratch.h"
+
+// Sorted multiset that absorbs appended batches cheaply. Each batch is sorted
+// on arrival with the 3-8 network merge sort and becomes a new level at the
+// end of one contiguous array. Levels are kept in decreasing size order by
+// merging the last two with merge() whenever the older one is no more than
+// twice the newer, so there are O(log n) levels and each element is merged
+// O(log n) times. sorted() compacts everything into a single level.
+class SortedAccumulator {
+public:
+    void append(const int* values, int count);
+
+    // Merges all levels and returns the values in ascending order. The
+    // reference stays valid until the next append().
+    const std::vector<int>& sorted();
+
+    int size() const {
+        return static_cast<int>(data_.size());
+    }
+
+    int levelCount() const {
+        return static_cast<int>(levelStarts_.size());
+    }
+
+    void clear();
+
+private:
+    // Merges the last two levels into one.
+    void mergeLastLevels();
+
+    std::vector<int> data_;
+    std::vector<int> levelStarts_;
+    SortScratch scratch_;
+};
+
+#endif
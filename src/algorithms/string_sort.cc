@@ -0,0 +1,141 @@
+#include "string_sort.h"
+#include "generic_sort.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace prefix_sort {
+    template<typename Key>
+    struct PrefixEntry {
+        Key key;
+        int index;
+    };
+
+    // Big-endian, so integer order matches byte order; missing bytes past the
+    // end of the string read as zero. Full words are loaded and byte-swapped
+    // (the AlphaDev kernels already tie the library to little-endian x86).
+    template<typename Key>
+    static Key loadPrefix(std::string_view str, size_t depth) {
+        size_t available = str.size() > depth ? str.size() - depth : 0;
+        if (available >= sizeof(Key)) {
+            Key key;
+            std::memcpy(&key, str.data() + depth, sizeof(Key));
+            if constexpr (sizeof(Key) == 8) {
+                return __builtin_bswap64(key);
+            } else {
+                return __builtin_bswap32(key);
+            }
+        }
+        Key key = 0;
+        size_t count = available;
+        for (size_t b = 0; b < count; b++) {
+            key |= static_cast<Key>(static_cast<unsigned char>(str[depth + b])) << (8 * (sizeof(Key) - 1 - b));
+        }
+        return key;
+    }
+
+    template<typename Key>
+    class PrefixSorter {
+    public:
+        explicit PrefixSorter(const std::string_view* strings) : strings_(strings) {}
+
+        // Sorts entries[0, size). Tied groups go on an explicit stack
+        // rather than the call stack, since strings sharing a long prefix
+        // need one pass per prefix word.
+        void sort(PrefixEntry<Key>* entries, int size) {
+            std::vector<Range> pending = {{0, size, 0}};
+            while (!pending.empty()) {
+                Range range = pending.back();
+                pending.pop_back();
+                sortRange(entries, range, pending);
+            }
+        }
+
+    private:
+        // entries[low, high) whose strings all share their first `depth`
+        // bytes.
+        struct Range {
+            int low;
+            int high;
+            size_t depth;
+        };
+
+        void sortRange(PrefixEntry<Key>* entries, const Range& range, std::vector<Range>& pending) {
+            for (int i = range.low; i < range.high; i++) {
+                entries[i].key = loadPrefix<Key>(strings_[entries[i].index], range.depth);
+            }
+            generic::quickSort(entries + range.low, range.high - range.low, std::less<>(), &PrefixEntry<Key>::key);
+
+            for (int start = range.low; start < range.high;) {
+                int end = start + 1;
+                while (end < range.high && entries[end].key == entries[start].key) end++;
+                if (end - start > 1) resolveTies(entries, start, end, range.depth, pending);
+                start = end;
+            }
+        }
+
+        // Strings ending within this prefix are prefixes of the ones that go
+        // on (the padding is zero), so they come first, shortest first; the
+        // rest continue on the next prefix.
+        void resolveTies(PrefixEntry<Key>* entries, int low, int high, size_t depth, std::vector<Range>& pending) {
+            size_t boundary = depth + sizeof(Key);
+            auto finished = [&](const PrefixEntry<Key>& entry) {
+                return strings_[entry.index].size() <= boundary;
+            };
+            int split = std::stable_partition(entries + low, entries + high, finished) - entries;
+            std::sort(entries + low, entries + split, [&](const PrefixEntry<Key>& a, const PrefixEntry<Key>& b) {
+                return strings_[a.index].size() < strings_[b.index].size();
+            });
+            if (high - split > 1) pending.push_back({split, high, boundary});
+        }
+
+        const std::string_view* strings_;
+    };
+
+    template<typename Key>
+    static std::vector<PrefixEntry<Key>> sortedEntries(const std::string_view* views, int size) {
+        std::vector<PrefixEntry<Key>> entries(size);
+        for (int i = 0; i < size; i++) {
+            entries[i].index = i;
+        }
+        PrefixSorter<Key>(views).sort(entries.data(), size);
+        return entries;
+    }
+
+    // Returns the sorted order as indices into `views`.
+    static std::vector<int> sortedOrder(const std::string_view* views, int size, int prefixBytes) {
+        std::vector<int> order(size);
+        if (prefixBytes == 4) {
+            std::vector<PrefixEntry<uint32_t>> entries = sortedEntries<uint32_t>(views, size);
+            for (int i = 0; i < size; i++) order[i] = entries[i].index;
+        } else {
+            std::vector<PrefixEntry<uint64_t>> entries = sortedEntries<uint64_t>(views, size);
+            for (int i = 0; i < size; i++) order[i] = entries[i].index;
+        }
+        return order;
+    }
+}
+
+void sortStrings(std::string* arr, int size, int prefixBytes) {
+    if (size <= 1) return;
+    std::vector<std::string_view> views(arr, arr + size);
+    std::vector<int> order = prefix_sort::sortedOrder(views.data(), size, prefixBytes);
+
+    std::vector<std::string> sorted(size);
+    for (int i = 0; i < size; i++) {
+        sorted[i] = std::move(arr[order[i]]);
+    }
+    std::move(sorted.begin(), sorted.end(), arr);
+}
+
+void sortStringViews(std::string_view* arr, int size, int prefixBytes) {
+    if (size <= 1) return;
+    std::vector<int> order = prefix_sort::sortedOrder(arr, size, prefixBytes);
+
+    std::vector<std::string_view> sorted(size);
+    for (int i = 0; i < size; i++) {
+        sorted[i] = arr[order[i]];
+    }
+    std::copy(sorted.begin(), sorted.end(), arr);
+}
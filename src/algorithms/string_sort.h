@@ -0,0 +1,16 @@
+#ifndef STRING_SORT_H_
+#define STRING_SORT_H_
+
+#include <string>
+#include <string_view>
+
+// Lexicographic (unsigned byte) string sort. Each string gets a cached
+// big-endian prefix of `prefixBytes` (4 or 8) bytes as an integer key; the
+// (key, index) pairs are sorted with the generic network quick sort, and each
+// run of equal keys is resolved multikey-quicksort style on the next prefix.
+// Strings are only touched when their keys are loaded, so most comparisons
+// run on a compact array of integers.
+void sortStrings(std::string* arr, int size, int prefixBytes = 8);
+void sortStringViews(std::string_view* arr, int size, int prefixBytes = 8);
+
+#endif
@@ -1,17 +1,54 @@
 #include <benchmark/benchmark.h>
-#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <map>
 #include <random>
+#include <string>
+#include <utility>
+#include <vector>
 #include "../algorithms/merge_sort_variants.h"
-#include "../algorithms/bitonic_sort.h"
 #include "../algorithms/quick_sort_variants.h"
+#include "../algorithms/adaptive_sort.h"
+#include "../algorithms/async_sort.h"
+#include "../algorithms/cache_info.h"
+#include "../algorithms/columnar_sort.h"
+#include "../algorithms/counting_sort.h"
+#include "../algorithms/float_sort.h"
+#include "../algorithms/generic_sort.h"
+#include "../algorithms/segmented_sort.h"
+#include "../algorithms/sorted_accumulator.h"
+#include "../algorithms/string_sort.h"
+#include "perf_counters.h"
+
+// Every input is generated from a fixed seed, once per (distribution, size),
+// and copied into the working buffer at the start of each iteration. This
+// keeps runs reproducible and avoids PauseTiming/ResumeTiming overhead.
+// Small sizes get several differently seeded inputs that the iterations
+// rotate through, so the branch predictor cannot memorise a single input.
+static const unsigned kSeed = 20230607;
+static const int kPoolElements = 1 << 18;
+
+enum class Distribution {
+    Random,
+    Sorted,
+    NearlySorted,
+    Reversed,
+    OrganPipe,
+    Sawtooth,
+    FewUnique,
+    Zipf,
+    MedianOf3Killer
+};
 
-static std::vector<int> generateRandomArray(size_t size) {
+static std::vector<int> generateRandomArray(int size, unsigned seed) {
     std::vector<int> arr(size);
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    std::mt19937 gen(seed);
     std::uniform_int_distribution<> dis(-1000000, 1000000);
-    
-    for(size_t i = 0; i < size; i++) {
+
+    for(int i = 0; i < size; i++) {
         arr[i] = dis(gen);
     }
     return arr;
@@ -25,13 +62,12 @@ static std::vector<int> generateSortedArray(int size) {
     return arr;
 }
 
-static std::vector<int> generateNearlySortedArray(int size) {
+static std::vector<int> generateNearlySortedArray(int size, unsigned seed) {
     auto arr = generateSortedArray(size);
     int swaps = size * 0.05;
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    std::mt19937 gen(seed);
     std::uniform_int_distribution<> dis(0, size - 1);
-    
+
     for(int i = 0; i < swaps; i++) {
         int idx1 = dis(gen);
         int idx2 = dis(gen);
@@ -40,140 +76,941 @@ static std::vector<int> generateNearlySortedArray(int size) {
     return arr;
 }
 
-#define BENCHMARK_MERGESORT(NAME, FUNC) \
-static void BM_##NAME##_Random(benchmark::State& state) { \
-    const size_t size = state.range(0); \
-    for (auto _ : state) { \
-        state.PauseTiming(); \
-        auto arr = generateRandomArray(size); \
-        state.ResumeTiming(); \
-        FUNC(arr.data(), size); \
-    } \
-    state.SetComplexityN(state.range(0)); \
-} \
-\
-static void BM_##NAME##_Sorted(benchmark::State& state) { \
-    const size_t size = state.range(0); \
-    for (auto _ : state) { \
-        state.PauseTiming(); \
-        auto arr = generateSortedArray(size); \
-        state.ResumeTiming(); \
-        FUNC(arr.data(), size); \
-    } \
-    state.SetComplexityN(state.range(0)); \
-} \
-\
-static void BM_##NAME##_NearlySorted(benchmark::State& state) { \
-    const size_t size = state.range(0); \
-    for (auto _ : state) { \
-        state.PauseTiming(); \
-        auto arr = generateNearlySortedArray(size); \
-        state.ResumeTiming(); \
-        FUNC(arr.data(), size); \
-    } \
-    state.SetComplexityN(state.range(0)); \
-}
-
-#define BENCHMARK_QUICKSORT(NAME, FUNC) \
-static void BM_##NAME##_Random(benchmark::State& state) { \
-    const size_t size = state.range(0); \
-    for (auto _ : state) { \
-        state.PauseTiming(); \
-        auto arr = generateRandomArray(size); \
-        state.ResumeTiming(); \
-        FUNC(arr.data(), size); \
-    } \
-    state.SetComplexityN(state.range(0)); \
-} \
-\
-static void BM_##NAME##_Sorted(benchmark::State& state) { \
-    const size_t size = state.range(0); \
-    for (auto _ : state) { \
-        state.PauseTiming(); \
-        auto arr = generateSortedArray(size); \
-        state.ResumeTiming(); \
-        FUNC(arr.data(), size); \
-    } \
-    state.SetComplexityN(state.range(0)); \
-} \
-\
-static void BM_##NAME##_NearlySorted(benchmark::State& state) { \
-    const size_t size = state.range(0); \
-    for (auto _ : state) { \
-        state.PauseTiming(); \
-        auto arr = generateNearlySortedArray(size); \
-        state.ResumeTiming(); \
-        FUNC(arr.data(), size); \
-    } \
-    state.SetComplexityN(state.range(0)); \
-}
-
-BENCHMARK_MERGESORT(MergeSortClassic, mergeSortClassic)
-BENCHMARK_MERGESORT(MergeSort3To8, mergeSort3To8)
-BENCHMARK_MERGESORT(MergeSort3, mergeSort3)
-BENCHMARK_MERGESORT(MergeSort3To4, mergeSort3To4)
-BENCHMARK_MERGESORT(MergeSort3To5, mergeSort3To5)
-BENCHMARK_MERGESORT(MergeSortEven, mergeSortEven)
-BENCHMARK_MERGESORT(MergeSortOdd, mergeSortOdd)
-BENCHMARK_MERGESORT(MergeSortPowerOf2, mergeSortPowerOf2)
-BENCHMARK_MERGESORT(MergeSortVarSort3, mergeSortVarSort3)
-BENCHMARK_MERGESORT(MergeSortVarSort4, mergeSortVarSort4)
-BENCHMARK_MERGESORT(MergeSortVarSort5, mergeSortVarSort5)
-
-BENCHMARK_MERGESORT(QuickSortClassic, quickSortClassic)
-BENCHMARK_MERGESORT(QuickSort3To8, quickSort3To8)
-BENCHMARK_MERGESORT(QuickSort3, quickSort3)
-BENCHMARK_MERGESORT(QuickSort3To4, quickSort3To4)
-BENCHMARK_MERGESORT(QuickSort3To5, quickSort3To5)
-BENCHMARK_MERGESORT(QuickSortEven, quickSortEven)
-BENCHMARK_MERGESORT(QuickSortOdd, quickSortOdd)
-BENCHMARK_MERGESORT(QuickSortPowerOf2, quickSortPowerOf2)
-BENCHMARK_MERGESORT(QuickSortVarSort3, quickSortVarSort3)
-BENCHMARK_MERGESORT(QuickSortVarSort4, quickSortVarSort4)
-BENCHMARK_MERGESORT(QuickSortVarSort5, quickSortVarSort5)
-
-#define REGISTERBENCHMARK(NAME)                                  \
-    BENCHMARK(BM##NAME##Random)                                  \
-        ->RangeMultiplier(2)                                     \
-        ->Range(1 << 10, 1 << 20)                                \
-        ->Unit(benchmark::kNanosecond)                          \
-        ->UseRealTime()                                         \
-        ->ReportAggregatesOnly(true);                           \
-    BENCHMARK(BM##NAME##Sorted)                                  \
-        ->RangeMultiplier(2)                                     \
-        ->Range(1 << 10, 1 << 20)                                \
-        ->Unit(benchmark::kNanosecond)                          \
-        ->UseRealTime()                                         \
-        ->ReportAggregatesOnly(true);                           \
-    BENCHMARK(BM##NAME##_NearlySorted)                           \
-        ->RangeMultiplier(2)                                     \
-        ->Range(1 << 10, 1 << 20)                                \
-        ->Unit(benchmark::kNanosecond)                          \
-        ->UseRealTime()                                         \
-        ->ReportAggregatesOnly(true);
-       
-REGISTER_BENCHMARK(MergeSortClassic)
-REGISTER_BENCHMARK(MergeSort3To8)
-REGISTER_BENCHMARK(MergeSort3)
-REGISTER_BENCHMARK(MergeSort3To4)
-REGISTER_BENCHMARK(MergeSort3To5)
-REGISTER_BENCHMARK(MergeSortEven)
-REGISTER_BENCHMARK(MergeSortOdd)
-REGISTER_BENCHMARK(MergeSortPowerOf2)
-REGISTER_BENCHMARK(MergeSortVarSort3)
-REGISTER_BENCHMARK(MergeSortVarSort4)
-REGISTER_BENCHMARK(MergeSortVarSort5)
-
-REGISTER_BENCHMARK(QuickSortClassic)
-REGISTER_BENCHMARK(QuickSort3To8)
-REGISTER_BENCHMARK(QuickSort3)
-REGISTER_BENCHMARK(QuickSort3To4)
-REGISTER_BENCHMARK(QuickSort3To5)
-REGISTER_BENCHMARK(QuickSortEven)
-REGISTER_BENCHMARK(QuickSortOdd)
-REGISTER_BENCHMARK(QuickSortPowerOf2)
-REGISTER_BENCHMARK(QuickSortVarSort3)
-REGISTER_BENCHMARK(QuickSortVarSort4)
-REGISTER_BENCHMARK(QuickSortVarSort5)
-
-BENCHMARK_MAIN();
\ No newline at end of file
+static std::vector<int> generateReversedArray(int size) {
+    std::vector<int> arr(size);
+    for(int i = 0; i < size; i++) {
+        arr[i] = size - i;
+    }
+    return arr;
+}
+
+static std::vector<int> generateOrganPipeArray(int size) {
+    std::vector<int> arr(size);
+    for(int i = 0; i < size; i++) {
+        arr[i] = i < size / 2 ? i : size - i;
+    }
+    return arr;
+}
+
+static std::vector<int> generateSawtoothArray(int size) {
+    std::vector<int> arr(size);
+    int period = std::max(1, size / 32);
+    for(int i = 0; i < size; i++) {
+        arr[i] = i % period;
+    }
+    return arr;
+}
+
+static std::vector<int> generateFewUniqueArray(int size, unsigned seed) {
+    std::vector<int> arr(size);
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> dis(0, 15);
+
+    for(int i = 0; i < size; i++) {
+        arr[i] = dis(gen);
+    }
+    return arr;
+}
+
+// Zipf(s = 1) over [1, size], sampled by inverting the cumulative weights.
+static std::vector<int> generateZipfArray(int size, unsigned seed) {
+    std::vector<double> cdf(size);
+    double total = 0;
+    for(int i = 0; i < size; i++) {
+        total += 1.0 / (i + 1);
+        cdf[i] = total;
+    }
+
+    std::vector<int> arr(size);
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<> dis(0, total);
+    for(int i = 0; i < size; i++) {
+        auto it = std::lower_bound(cdf.begin(), cdf.end(), dis(gen));
+        arr[i] = std::min<int>(it - cdf.begin(), size - 1) + 1;
+    }
+    return arr;
+}
+
+// Musser's median-of-3 killer sequence ("Introspective Sorting and
+// Selection Algorithms", 1997). The construction needs size = 2k with k
+// even, so it covers the largest multiple of 4 and the remaining values
+// follow in order.
+static std::vector<int> generateMedianOf3KillerArray(int size) {
+    std::vector<int> arr(size);
+    int killerSize = size - size % 4;
+    int k = killerSize / 2;
+    for(int i = 1; i <= k; i++) {
+        if (i % 2 == 1) {
+            arr[i - 1] = i;
+            arr[i] = k + i;
+        }
+        arr[k + i - 1] = 2 * i;
+    }
+    for(int i = killerSize; i < size; i++) {
+        arr[i] = i + 1;
+    }
+    return arr;
+}
+
+static std::vector<int> generateArray(Distribution dist, int size, unsigned seed) {
+    switch (dist) {
+        case Distribution::Random: return generateRandomArray(size, seed);
+        case Distribution::Sorted: return generateSortedArray(size);
+        case Distribution::NearlySorted: return generateNearlySortedArray(size, seed);
+        case Distribution::Reversed: return generateReversedArray(size);
+        case Distribution::OrganPipe: return generateOrganPipeArray(size);
+        case Distribution::Sawtooth: return generateSawtoothArray(size);
+        case Distribution::FewUnique: return generateFewUniqueArray(size, seed);
+        case Distribution::Zipf: return generateZipfArray(size, seed);
+        case Distribution::MedianOf3Killer: return generateMedianOf3KillerArray(size);
+    }
+    return {};
+}
+
+struct InputPool {
+    int size;
+    int count;
+    std::vector<int> data;
+
+    const int* at(size_t iteration) const {
+        return data.data() + (iteration % count) * size;
+    }
+};
+
+static const InputPool& getInput(Distribution dist, int size) {
+    static std::map<std::pair<Distribution, int>, InputPool> pools;
+    auto key = std::make_pair(dist, size);
+    auto it = pools.find(key);
+    if (it == pools.end()) {
+        InputPool pool{size, std::max(1, kPoolElements / size), {}};
+        pool.data.reserve(static_cast<size_t>(pool.count) * size);
+        for (int i = 0; i < pool.count; i++) {
+            auto arr = generateArray(dist, size, kSeed + i);
+            pool.data.insert(pool.data.end(), arr.begin(), arr.end());
+        }
+        it = pools.emplace(key, std::move(pool)).first;
+    }
+    return it->second;
+}
+
+static void BM_Sort(benchmark::State& state, void (*sortFunc)(int*, int), Distribution dist) {
+    const int size = state.range(0);
+    const InputPool& input = getInput(dist, size);
+    size_t iteration = 0;
+    std::vector<int> arr(size);
+    PerfCounters perf;
+    perf.start();
+    for (auto _ : state) {
+        std::memcpy(arr.data(), input.at(iteration++), size * sizeof(int));
+        sortFunc(arr.data(), size);
+        benchmark::ClobberMemory();
+    }
+    perf.stop();
+    perf.report(state, static_cast<double>(state.iterations()) * size);
+    state.SetComplexityN(size);
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+static void BM_Pivot(benchmark::State& state, PivotSelection pivot, PartitionScheme partition,
+                     Distribution dist) {
+    const int size = state.range(0);
+    const InputPool& input = getInput(dist, size);
+    size_t iteration = 0;
+    std::vector<int> arr(size);
+    int depth = 0;
+    PerfCounters perf;
+    perf.start();
+    for (auto _ : state) {
+        std::memcpy(arr.data(), input.at(iteration++), size * sizeof(int));
+        depth = quickSort3To8MaxDepth(arr.data(), size, pivot, partition);
+        benchmark::ClobberMemory();
+    }
+    perf.stop();
+    perf.report(state, static_cast<double>(state.iterations()) * size);
+    state.counters["max_depth"] = depth;
+    state.SetComplexityN(size);
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// Sorts through a SortScratch reused across iterations, so the steady state
+// allocates nothing; reports the scratch the variant needed.
+static void BM_SortWithScratch(benchmark::State& state, void (*sortFunc)(int*, int, SortScratch&),
+                               Distribution dist) {
+    const int size = state.range(0);
+    const InputPool& input = getInput(dist, size);
+    size_t iteration = 0;
+    std::vector<int> arr(size);
+    SortScratch scratch;
+    PerfCounters perf;
+    perf.start();
+    for (auto _ : state) {
+        std::memcpy(arr.data(), input.at(iteration++), size * sizeof(int));
+        sortFunc(arr.data(), size, scratch);
+        benchmark::ClobberMemory();
+    }
+    perf.stop();
+    perf.report(state, static_cast<double>(state.iterations()) * size);
+    state.counters["peak_scratch_bytes"] = scratch.capacityBytes();
+    state.SetComplexityN(size);
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// Sizes on both sides of each detected cache level, labelled with the level
+// the input fits in.
+static const int kMaxCacheSweepSize = 1 << 25;
+
+static const char* cacheLevelLabel(int size) {
+    const CacheSizes& caches = detectCacheSizes();
+    size_t bytes = static_cast<size_t>(size) * sizeof(int);
+    if (bytes <= caches.l1d) return "L1";
+    if (bytes <= caches.l2) return "L2";
+    if (bytes <= caches.l3) return "L3";
+    return "DRAM";
+}
+
+static void cacheSweepSizes(benchmark::internal::Benchmark* b) {
+    const CacheSizes& caches = detectCacheSizes();
+    for (size_t bytes : {caches.l1d, caches.l2, caches.l3}) {
+        for (size_t scaled : {bytes / 2, bytes * 2}) {
+            size_t elements = scaled / sizeof(int);
+            if (elements <= static_cast<size_t>(kMaxCacheSweepSize)) {
+                b->Arg(static_cast<int>(elements));
+            }
+        }
+    }
+    b->Arg(kMaxCacheSweepSize);
+}
+
+static void BM_CacheSweep(benchmark::State& state, void (*sortFunc)(int*, int, SortScratch&)) {
+    BM_SortWithScratch(state, sortFunc, Distribution::Random);
+    state.SetLabel(cacheLevelLabel(state.range(0)));
+}
+
+// Calibrates the software prefetch distance on inputs far larger than the
+// LLC; distance 0 is the non-prefetching baseline.
+static void BM_PrefetchDistance(benchmark::State& state, void (*sortFunc)(int*, int, int)) {
+    const int size = state.range(0);
+    const int distance = state.range(1);
+    const InputPool& input = getInput(Distribution::Random, size);
+    size_t iteration = 0;
+    std::vector<int> arr(size);
+    for (auto _ : state) {
+        std::memcpy(arr.data(), input.at(iteration++), size * sizeof(int));
+        sortFunc(arr.data(), size, distance);
+        benchmark::ClobberMemory();
+    }
+    state.counters["prefetch_distance"] = distance;
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+static void prefetchSweep(benchmark::internal::Benchmark* b) {
+    for (int size : {1 << 24, 1 << 25}) {
+        for (int distance : {0, 64, 128, 256, 512, 1024, 2048}) {
+            b->Args({size, distance});
+        }
+    }
+}
+
+// Compares streaming-store thresholds on inputs far larger than the LLC. The
+// second argument divides the detected L3 size; 0 disables streaming.
+static void BM_StreamingThreshold(benchmark::State& state) {
+    const int size = state.range(0);
+    const int divisor = state.range(1);
+    const size_t threshold = divisor ? detectCacheSizes().l3 / divisor : SIZE_MAX;
+    const InputPool& input = getInput(Distribution::Random, size);
+    size_t iteration = 0;
+    std::vector<int> arr(size);
+    SortScratch scratch;
+    PerfCounters perf;
+    perf.start();
+    for (auto _ : state) {
+        std::memcpy(arr.data(), input.at(iteration++), size * sizeof(int));
+        mergeSort3To8Streaming(arr.data(), size, threshold, scratch);
+        benchmark::ClobberMemory();
+    }
+    perf.stop();
+    perf.report(state, static_cast<double>(state.iterations()) * size);
+    state.SetLabel(divisor ? "L3/" + std::to_string(divisor) : "off");
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+static void streamingSweep(benchmark::internal::Benchmark* b) {
+    for (int size : {1 << 22, 1 << 23, 1 << 24, 1 << 25}) {
+        for (int divisor : {0, 1, 4}) {
+            b->Args({size, divisor});
+        }
+    }
+}
+
+// Selection: the second argument is k (n for nthElement, taken as k - 1).
+// Full sorts and the std algorithms are the baselines.
+static void BM_Selection(benchmark::State& state, void (*selectFunc)(int*, int, int)) {
+    const int size = state.range(0);
+    const int k = state.range(1);
+    const InputPool& input = getInput(Distribution::Random, size);
+    size_t iteration = 0;
+    std::vector<int> arr(size);
+    PerfCounters perf;
+    perf.start();
+    for (auto _ : state) {
+        std::memcpy(arr.data(), input.at(iteration++), size * sizeof(int));
+        selectFunc(arr.data(), size, k);
+        benchmark::ClobberMemory();
+    }
+    perf.stop();
+    perf.report(state, static_cast<double>(state.iterations()) * size);
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+static void selectionSweep(benchmark::internal::Benchmark* b) {
+    for (int size : {1 << 16, 1 << 20}) {
+        for (int k = 10; k < size / 2; k *= 10) {
+            b->Args({size, k});
+        }
+        b->Args({size, size / 2});
+    }
+}
+
+static void nthElementKth(int* arr, int size, int k) {
+    nthElement(arr, size, k - 1);
+}
+
+static void stdNthElement(int* arr, int size, int k) {
+    std::nth_element(arr, arr + k - 1, arr + size);
+}
+
+static void stdPartialSort(int* arr, int size, int k) {
+    std::partial_sort(arr, arr + k, arr + size);
+}
+
+static void fullQuickSort3To8(int* arr, int size, int) {
+    quickSort3To8(arr, size);
+}
+
+// Incremental sorting: builds a sorted array of kAccumulatedElements from
+// batches of range(0) values. The accumulator is read (compacted) every
+// range(1) batches, or only at the end when it is 0; the baseline re-sorts the
+// whole array after every batch.
+static const int kAccumulatedElements = 1 << 14;
+
+static void BM_AccumulatorAppend(benchmark::State& state) {
+    const int batch = state.range(0);
+    const int readEvery = state.range(1);
+    const InputPool& input = getInput(Distribution::Random, kAccumulatedElements);
+    size_t iteration = 0;
+    SortedAccumulator accumulator;
+    for (auto _ : state) {
+        const int* values = input.at(iteration++);
+        accumulator.clear();
+        for (int start = 0, index = 1; start < kAccumulatedElements; start += batch, index++) {
+            accumulator.append(values + start, std::min(batch, kAccumulatedElements - start));
+            if (readEvery && index % readEvery == 0) {
+                benchmark::DoNotOptimize(accumulator.sorted().data());
+            }
+        }
+        benchmark::DoNotOptimize(accumulator.sorted().data());
+    }
+    state.SetItemsProcessed(state.iterations() * kAccumulatedElements);
+}
+
+static void BM_ResortAppend(benchmark::State& state) {
+    const int batch = state.range(0);
+    const InputPool& input = getInput(Distribution::Random, kAccumulatedElements);
+    size_t iteration = 0;
+    std::vector<int> arr;
+    arr.reserve(kAccumulatedElements);
+    SortScratch scratch;
+    for (auto _ : state) {
+        const int* values = input.at(iteration++);
+        arr.clear();
+        for (int start = 0; start < kAccumulatedElements; start += batch) {
+            arr.insert(arr.end(), values + start, values + std::min(start + batch, kAccumulatedElements));
+            mergeSort3To8(arr.data(), arr.size(), scratch);
+        }
+        benchmark::DoNotOptimize(arr.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kAccumulatedElements);
+}
+
+// Sort + deduplicate; reports the fraction of values that survive.
+static void BM_SortUnique(benchmark::State& state, int (*sortUniqueFunc)(int*, int, SortScratch&),
+                          Distribution dist) {
+    const int size = state.range(0);
+    const InputPool& input = getInput(dist, size);
+    size_t iteration = 0;
+    std::vector<int> arr(size);
+    SortScratch scratch;
+    int length = 0;
+    PerfCounters perf;
+    perf.start();
+    for (auto _ : state) {
+        std::memcpy(arr.data(), input.at(iteration++), size * sizeof(int));
+        length = sortUniqueFunc(arr.data(), size, scratch);
+        benchmark::ClobberMemory();
+    }
+    perf.stop();
+    perf.report(state, static_cast<double>(state.iterations()) * size);
+    state.counters["unique_fraction"] = static_cast<double>(length) / size;
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+static int mergeSort3To8ThenUnique(int* arr, int size, SortScratch& scratch) {
+    mergeSort3To8(arr, size, scratch);
+    return std::unique(arr, arr + size) - arr;
+}
+
+// Generic engines: ints through the AlphaDev leaves (ascending, and
+// descending via the complement), and records ordered by a projected key.
+static void genericMergeSort3To8(int* arr, int size) {
+    generic::mergeSort(arr, size);
+}
+
+static void genericMergeSort3To8Descending(int* arr, int size) {
+    generic::mergeSort(arr, size, std::greater<>());
+}
+
+static void genericQuickSort3To8(int* arr, int size) {
+    generic::quickSort(arr, size);
+}
+
+static void genericQuickSort3To8Descending(int* arr, int size) {
+    generic::quickSort(arr, size, std::greater<>());
+}
+
+struct KeyedRecord {
+    int key;
+    int payload[3];
+};
+
+static void BM_SortRecords(benchmark::State& state, bool useMergeSort) {
+    const int size = state.range(0);
+    const InputPool& input = getInput(Distribution::Random, size);
+    size_t iteration = 0;
+    std::vector<KeyedRecord> records(size);
+    for (auto _ : state) {
+        const int* keys = input.at(iteration++);
+        for (int i = 0; i < size; i++) {
+            records[i] = {keys[i], {i, i, i}};
+        }
+        if (useMergeSort) {
+            generic::mergeSort(records.data(), size, std::less<>(), &KeyedRecord::key);
+        } else {
+            generic::quickSort(records.data(), size, std::less<>(), &KeyedRecord::key);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// Strings: random lowercase keys of 8-24 bytes, or paths sharing a long
+// common prefix. Like InputPool, iterations rotate through seeded copies so
+// the input is not learned across iterations.
+enum class StringInput {
+    Keys,
+    Paths
+};
+
+static std::vector<std::string> generateStrings(StringInput kind, int size, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> length(8, 24);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::vector<std::string> strings(size);
+    for (std::string& str : strings) {
+        if (kind == StringInput::Paths) {
+            str = "/srv/data/shard" + std::to_string(gen() % 16) + "/";
+        }
+        int n = length(gen);
+        for (int i = 0; i < n; i++) {
+            str += static_cast<char>(letter(gen));
+        }
+    }
+    return strings;
+}
+
+static void stdSortStrings(std::string* arr, int size, int) {
+    std::sort(arr, arr + size);
+}
+
+static void BM_StringSort(benchmark::State& state, void (*sortFunc)(std::string*, int, int), int prefixBytes,
+                          StringInput kind) {
+    const int size = state.range(0);
+    std::vector<std::vector<std::string>> pool(std::max(1, kPoolElements / size));
+    for (size_t i = 0; i < pool.size(); i++) {
+        pool[i] = generateStrings(kind, size, kSeed + i);
+    }
+    size_t iteration = 0;
+    std::vector<std::string> work(size);
+    for (auto _ : state) {
+        const std::vector<std::string>& input = pool[iteration++ % pool.size()];
+        std::copy(input.begin(), input.end(), work.begin());
+        sortFunc(work.data(), size, prefixBytes);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// Floating point: the random int pool scaled into signed fractional values.
+template<typename Float>
+static void stdSortFloats(Float* arr, int size) {
+    std::sort(arr, arr + size);
+}
+
+template<typename Float>
+static void runFloatSort(benchmark::State& state, void (*sortFunc)(Float*, int)) {
+    const int size = state.range(0);
+    const InputPool& input = getInput(Distribution::Random, size);
+    size_t iteration = 0;
+    std::vector<Float> arr(size);
+    for (auto _ : state) {
+        const int* values = input.at(iteration++);
+        for (int i = 0; i < size; i++) {
+            arr[i] = static_cast<Float>(values[i] - size / 2) / 7;
+        }
+        sortFunc(arr.data(), size);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+static void BM_FloatSort(benchmark::State& state, void (*sortFunc)(float*, int)) {
+    runFloatSort(state, sortFunc);
+}
+
+static void BM_DoubleSort(benchmark::State& state, void (*sortFunc)(double*, int)) {
+    runFloatSort(state, sortFunc);
+}
+
+// ORDER BY a, b over a table with two int key columns (a has 16 distinct
+// values, so b mostly breaks ties) and two payload columns. The baseline
+// materialises row structs, sorts them, and writes the columns back.
+struct TableColumns {
+    std::vector<int> a, b, payload1, payload2;
+};
+
+static TableColumns generateTable(int rows) {
+    const InputPool& input = getInput(Distribution::Random, rows);
+    TableColumns table;
+    table.b.assign(input.at(0), input.at(0) + rows);
+    table.a.resize(rows);
+    table.payload1.resize(rows);
+    table.payload2.resize(rows);
+    for (int i = 0; i < rows; i++) {
+        table.a[i] = table.b[i] % 16;
+        table.payload1[i] = i;
+        table.payload2[i] = -i;
+    }
+    return table;
+}
+
+static void sortTableColumnar(TableColumns& table) {
+    int* keys[] = {table.a.data(), table.b.data()};
+    int* payloads[] = {table.payload1.data(), table.payload2.data()};
+    sortTable(keys, 2, payloads, 2, table.a.size());
+}
+
+static void sortTableRows(TableColumns& table) {
+    struct Row {
+        int a, b, payload1, payload2;
+    };
+    int rows = table.a.size();
+    std::vector<Row> materialised(rows);
+    for (int i = 0; i < rows; i++) {
+        materialised[i] = {table.a[i], table.b[i], table.payload1[i], table.payload2[i]};
+    }
+    std::stable_sort(materialised.begin(), materialised.end(), [](const Row& x, const Row& y) {
+        return x.a != y.a ? x.a < y.a : x.b < y.b;
+    });
+    for (int i = 0; i < rows; i++) {
+        table.a[i] = materialised[i].a;
+        table.b[i] = materialised[i].b;
+        table.payload1[i] = materialised[i].payload1;
+        table.payload2[i] = materialised[i].payload2;
+    }
+}
+
+static void BM_TableSort(benchmark::State& state, void (*sortFunc)(TableColumns&)) {
+    const int rows = state.range(0);
+    const TableColumns original = generateTable(rows);
+    TableColumns table;
+    for (auto _ : state) {
+        table = original;
+        sortFunc(table);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * rows);
+}
+
+// Segmented sort over a CSR buffer of about 2^22 values: mostly tiny
+// segments, a long tail of medium ones and a handful larger than L2.
+// range(0) is the thread count; 0 runs quickSort3To8 per segment instead.
+static std::vector<int> generateSegmentOffsets() {
+    std::mt19937 gen(kSeed);
+    std::vector<int> offsets = {0};
+    while (offsets.back() < (1 << 22)) {
+        int kind = gen() % 1000;
+        int size = kind < 700 ? gen() % 9 : kind < 998 ? gen() % 4096 : 1 << 19;
+        offsets.push_back(offsets.back() + size);
+    }
+    return offsets;
+}
+
+static void BM_SegmentedSort(benchmark::State& state) {
+    const int threads = state.range(0);
+    static const std::vector<int> offsets = generateSegmentOffsets();
+    const int segmentCount = offsets.size() - 1;
+    const int size = offsets.back();
+    const std::vector<int> original = generateRandomArray(size, kSeed);
+    std::vector<int> data(size);
+    for (auto _ : state) {
+        std::copy(original.begin(), original.end(), data.begin());
+        if (threads == 0) {
+            for (int s = 0; s < segmentCount; s++) {
+                quickSort3To8(data.data() + offsets[s], offsets[s + 1] - offsets[s]);
+            }
+        } else {
+            segmentedSort(data.data(), offsets.data(), segmentCount, threads);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.counters["segments"] = segmentCount;
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// Decode-then-sort pipeline over 16 batches of 2^18 ints. "Decoding" is a
+// copy that mixes every value, standing in for parsing the next buffer.
+// range(0) is 0 to decode and sort each batch in turn, 1 to hand each sort to
+// the shared async pool while the next batch decodes.
+static void decodeBatch(const int* source, int* batch, int size) {
+    for (int i = 0; i < size; i++) {
+        uint32_t x = source[i];
+        x ^= x >> 13;
+        x *= 0x5bd1e995u;
+        batch[i] = static_cast<int>(x ^ (x >> 15));
+    }
+}
+
+static void BM_AsyncPipeline(benchmark::State& state) {
+    const bool async = state.range(0);
+    const int batches = 16;
+    const int batchSize = 1 << 18;
+    const std::vector<int> source = generateRandomArray(batchSize, kSeed);
+    std::vector<std::vector<int>> data(batches, std::vector<int>(batchSize));
+    std::vector<SortHandle> handles(batches);
+    for (auto _ : state) {
+        for (int b = 0; b < batches; b++) {
+            decodeBatch(source.data(), data[b].data(), batchSize);
+            if (async) {
+                handles[b] = sortAsync(quickSort3To8, data[b].data(), batchSize);
+            } else {
+                quickSort3To8(data[b].data(), batchSize);
+            }
+        }
+        if (async) {
+            for (SortHandle& handle : handles) {
+                handle.wait();
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * batches * batchSize);
+}
+
+// Counting sort against quickSort3To8 as the value range grows relative to n.
+// range(0) is the size, range(1) the number of distinct possible values per
+// 16 elements, range(2) the engine: 0 quickSort3To8, 1 countingSort (range
+// detection included), 2 countingSort3To8 with its automatic fallback.
+static void BM_CountingSort(benchmark::State& state) {
+    const int size = state.range(0);
+    const int64_t span = std::max<int64_t>(1, int64_t(size) * state.range(1) / 16);
+    const int engine = state.range(2);
+    std::mt19937 gen(kSeed);
+    std::uniform_int_distribution<int64_t> dis(-span / 2, -span / 2 + span - 1);
+    std::vector<int> original(size);
+    for (int& value : original) {
+        value = static_cast<int>(dis(gen));
+    }
+    std::vector<int> data(size);
+    for (auto _ : state) {
+        std::copy(original.begin(), original.end(), data.begin());
+        if (engine == 0) {
+            quickSort3To8(data.data(), size);
+        } else if (engine == 1) {
+            int minValue, maxValue;
+            findRange(data.data(), size, &minValue, &maxValue);
+            countingSort(data.data(), size, minValue, maxValue);
+        } else {
+            countingSort3To8(data.data(), size);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.counters["counting"] = shouldUseCountingSort(size, -span / 2, -span / 2 + span - 1);
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+static void countingSweep(benchmark::internal::Benchmark* b) {
+    for (int size : {1 << 8, 1 << 12, 1 << 16, 1 << 20}) {
+        for (int valuesPer16 : {1, 16, 64, 128, 256}) {
+            for (int engine : {0, 1, 2}) {
+                b->Args({size, valuesPer16, engine});
+            }
+        }
+    }
+}
+
+#define REGISTER_SORT_BENCHMARK(NAME, FUNC, DIST)                   \
+    BENCHMARK_CAPTURE(BM_Sort, NAME##_##DIST, FUNC, Distribution::DIST) \
+        ->RangeMultiplier(2)                                        \
+        ->Range(1 << 10, 1 << 20)                                   \
+        ->Unit(benchmark::kNanosecond)                              \
+        ->UseRealTime()                                             \
+        ->DisplayAggregatesOnly(true);
+
+#define REGISTER_BENCHMARK(NAME, FUNC)                              \
+    REGISTER_SORT_BENCHMARK(NAME, FUNC, Random)                     \
+    REGISTER_SORT_BENCHMARK(NAME, FUNC, Sorted)                     \
+    REGISTER_SORT_BENCHMARK(NAME, FUNC, NearlySorted)               \
+    REGISTER_SORT_BENCHMARK(NAME, FUNC, Reversed)                   \
+    REGISTER_SORT_BENCHMARK(NAME, FUNC, OrganPipe)                  \
+    REGISTER_SORT_BENCHMARK(NAME, FUNC, Sawtooth)                   \
+    REGISTER_SORT_BENCHMARK(NAME, FUNC, FewUnique)                  \
+    REGISTER_SORT_BENCHMARK(NAME, FUNC, Zipf)                       \
+    REGISTER_SORT_BENCHMARK(NAME, FUNC, MedianOf3Killer)
+
+REGISTER_BENCHMARK(MergeSortClassic, mergeSortClassic)
+REGISTER_BENCHMARK(MergeSort3To8, mergeSort3To8)
+REGISTER_BENCHMARK(MergeSort3, mergeSort3)
+REGISTER_BENCHMARK(MergeSort3To4, mergeSort3To4)
+REGISTER_BENCHMARK(MergeSort3To5, mergeSort3To5)
+REGISTER_BENCHMARK(MergeSortEven, mergeSortEven)
+REGISTER_BENCHMARK(MergeSortOdd, mergeSortOdd)
+REGISTER_BENCHMARK(MergeSortPowerOf2, mergeSortPowerOf2)
+REGISTER_BENCHMARK(MergeSortVarSort3, mergeSortVarSort3)
+REGISTER_BENCHMARK(MergeSortVarSort4, mergeSortVarSort4)
+REGISTER_BENCHMARK(MergeSortVarSort5, mergeSortVarSort5)
+
+REGISTER_BENCHMARK(MergeSortInPlaceClassic, mergeSortInPlaceClassic)
+REGISTER_BENCHMARK(MergeSortInPlace3To8, mergeSortInPlace3To8)
+REGISTER_BENCHMARK(MergeSortInPlace3, mergeSortInPlace3)
+REGISTER_BENCHMARK(MergeSortInPlace3To4, mergeSortInPlace3To4)
+REGISTER_BENCHMARK(MergeSortInPlace3To5, mergeSortInPlace3To5)
+REGISTER_BENCHMARK(MergeSortInPlaceEven, mergeSortInPlaceEven)
+REGISTER_BENCHMARK(MergeSortInPlaceOdd, mergeSortInPlaceOdd)
+REGISTER_BENCHMARK(MergeSortInPlacePowerOf2, mergeSortInPlacePowerOf2)
+REGISTER_BENCHMARK(MergeSortInPlaceVarSort3, mergeSortInPlaceVarSort3)
+REGISTER_BENCHMARK(MergeSortInPlaceVarSort4, mergeSortInPlaceVarSort4)
+REGISTER_BENCHMARK(MergeSortInPlaceVarSort5, mergeSortInPlaceVarSort5)
+
+REGISTER_BENCHMARK(QuickSortClassic, quickSortClassic)
+REGISTER_BENCHMARK(QuickSort3To8, quickSort3To8)
+REGISTER_BENCHMARK(QuickSort3, quickSort3)
+REGISTER_BENCHMARK(QuickSort3To4, quickSort3To4)
+REGISTER_BENCHMARK(QuickSort3To5, quickSort3To5)
+REGISTER_BENCHMARK(QuickSortEven, quickSortEven)
+REGISTER_BENCHMARK(QuickSortOdd, quickSortOdd)
+REGISTER_BENCHMARK(QuickSortPowerOf2, quickSortPowerOf2)
+REGISTER_BENCHMARK(QuickSortVarSort3, quickSortVarSort3)
+REGISTER_BENCHMARK(QuickSortVarSort4, quickSortVarSort4)
+REGISTER_BENCHMARK(QuickSortVarSort5, quickSortVarSort5)
+
+REGISTER_BENCHMARK(MergeSortNatural3To8, mergeSortNatural3To8)
+REGISTER_BENCHMARK(QuickSort3To8ThreeWay, quickSort3To8ThreeWay)
+REGISTER_BENCHMARK(CountingSort3To8, countingSort3To8)
+REGISTER_BENCHMARK(AdaptiveSort, ::sort)
+
+#define REGISTER_SCRATCH_BENCHMARK(NAME, FUNC)                      \
+    BENCHMARK_CAPTURE(BM_SortWithScratch, NAME##_Random, FUNC, Distribution::Random) \
+        ->RangeMultiplier(4)                                        \
+        ->Range(1 << 10, 1 << 20)                                   \
+        ->Unit(benchmark::kNanosecond)                              \
+        ->UseRealTime();
+
+REGISTER_SCRATCH_BENCHMARK(MergeSortClassic, mergeSortClassic)
+REGISTER_SCRATCH_BENCHMARK(MergeSort3To8, mergeSort3To8)
+REGISTER_SCRATCH_BENCHMARK(MergeSort3, mergeSort3)
+REGISTER_SCRATCH_BENCHMARK(MergeSort3To4, mergeSort3To4)
+REGISTER_SCRATCH_BENCHMARK(MergeSort3To5, mergeSort3To5)
+REGISTER_SCRATCH_BENCHMARK(MergeSortEven, mergeSortEven)
+REGISTER_SCRATCH_BENCHMARK(MergeSortOdd, mergeSortOdd)
+REGISTER_SCRATCH_BENCHMARK(MergeSortPowerOf2, mergeSortPowerOf2)
+REGISTER_SCRATCH_BENCHMARK(MergeSortVarSort3, mergeSortVarSort3)
+REGISTER_SCRATCH_BENCHMARK(MergeSortVarSort4, mergeSortVarSort4)
+REGISTER_SCRATCH_BENCHMARK(MergeSortVarSort5, mergeSortVarSort5)
+
+#define REGISTER_CACHE_SWEEP_BENCHMARK(NAME, FUNC)                  \
+    BENCHMARK_CAPTURE(BM_CacheSweep, NAME, FUNC)                    \
+        ->Apply(cacheSweepSizes)                                    \
+        ->Unit(benchmark::kNanosecond)                              \
+        ->UseRealTime();
+
+REGISTER_CACHE_SWEEP_BENCHMARK(MergeSort3To8, mergeSort3To8)
+REGISTER_CACHE_SWEEP_BENCHMARK(MergeSort3To8CacheAware, mergeSort3To8CacheAware)
+
+#define REGISTER_PREFETCH_BENCHMARK(NAME, FUNC)                     \
+    BENCHMARK_CAPTURE(BM_PrefetchDistance, NAME, FUNC)              \
+        ->Apply(prefetchSweep)                                      \
+        ->Unit(benchmark::kMillisecond)                             \
+        ->UseRealTime();
+
+REGISTER_PREFETCH_BENCHMARK(MergeSort3To8, mergeSort3To8Prefetch)
+REGISTER_PREFETCH_BENCHMARK(QuickSort3To8, quickSort3To8Prefetch)
+
+BENCHMARK(BM_StreamingThreshold)
+    ->Apply(streamingSweep)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+#define REGISTER_SELECTION_BENCHMARK(NAME, FUNC)                    \
+    BENCHMARK_CAPTURE(BM_Selection, NAME, FUNC)                     \
+        ->Apply(selectionSweep)                                     \
+        ->Unit(benchmark::kMicrosecond)                             \
+        ->UseRealTime();
+
+REGISTER_SELECTION_BENCHMARK(NthElement, nthElementKth)
+REGISTER_SELECTION_BENCHMARK(TopK, topK)
+REGISTER_SELECTION_BENCHMARK(PartialSort, partialSort)
+REGISTER_SELECTION_BENCHMARK(StdNthElement, stdNthElement)
+REGISTER_SELECTION_BENCHMARK(StdPartialSort, stdPartialSort)
+REGISTER_SELECTION_BENCHMARK(QuickSort3To8, fullQuickSort3To8)
+
+BENCHMARK(BM_AccumulatorAppend)
+    ->Args({64, 0})->Args({64, 1})->Args({64, 16})
+    ->Args({1024, 0})->Args({1024, 1})->Args({1024, 16})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+BENCHMARK(BM_ResortAppend)
+    ->Arg(64)
+    ->Arg(1024)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+#define REGISTER_UNIQUE_BENCHMARK(NAME, FUNC, DIST)                 \
+    BENCHMARK_CAPTURE(BM_SortUnique, NAME##_##DIST, FUNC, Distribution::DIST) \
+        ->RangeMultiplier(4)                                        \
+        ->Range(1 << 10, 1 << 20)                                   \
+        ->UseRealTime();
+
+#define REGISTER_UNIQUE_BENCHMARKS(DIST)                            \
+    REGISTER_UNIQUE_BENCHMARK(MergeSortUnique3To8, mergeSortUnique3To8, DIST) \
+    REGISTER_UNIQUE_BENCHMARK(MergeSort3To8ThenUnique, mergeSort3To8ThenUnique, DIST)
+
+REGISTER_UNIQUE_BENCHMARKS(Random)
+REGISTER_UNIQUE_BENCHMARKS(FewUnique)
+REGISTER_UNIQUE_BENCHMARKS(Zipf)
+
+REGISTER_SORT_BENCHMARK(GenericMergeSort3To8, genericMergeSort3To8, Random)
+REGISTER_SORT_BENCHMARK(GenericMergeSort3To8Descending, genericMergeSort3To8Descending, Random)
+REGISTER_SORT_BENCHMARK(GenericQuickSort3To8, genericQuickSort3To8, Random)
+REGISTER_SORT_BENCHMARK(GenericQuickSort3To8Descending, genericQuickSort3To8Descending, Random)
+
+BENCHMARK_CAPTURE(BM_SortRecords, MergeSort3To8, true)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 20)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_SortRecords, QuickSort3To8, false)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 20)
+    ->UseRealTime();
+
+#define REGISTER_STRING_BENCHMARK(NAME, FUNC, PREFIX, KIND)         \
+    BENCHMARK_CAPTURE(BM_StringSort, NAME##_##KIND, FUNC, PREFIX, StringInput::KIND) \
+        ->RangeMultiplier(4)                                        \
+        ->Range(1 << 10, 1 << 18)                                   \
+        ->UseRealTime();
+
+REGISTER_STRING_BENCHMARK(Prefix4, sortStrings, 4, Keys)
+REGISTER_STRING_BENCHMARK(Prefix8, sortStrings, 8, Keys)
+REGISTER_STRING_BENCHMARK(StdSort, stdSortStrings, 0, Keys)
+REGISTER_STRING_BENCHMARK(Prefix4, sortStrings, 4, Paths)
+REGISTER_STRING_BENCHMARK(Prefix8, sortStrings, 8, Paths)
+REGISTER_STRING_BENCHMARK(StdSort, stdSortStrings, 0, Paths)
+
+#define REGISTER_FLOAT_BENCHMARK(BENCH, NAME, FUNC)                 \
+    BENCHMARK_CAPTURE(BENCH, NAME, FUNC)                            \
+        ->RangeMultiplier(4)                                        \
+        ->Range(1 << 10, 1 << 20)                                   \
+        ->UseRealTime();
+
+REGISTER_FLOAT_BENCHMARK(BM_FloatSort, MergeSort3To8, mergeSort3To8)
+REGISTER_FLOAT_BENCHMARK(BM_FloatSort, QuickSort3To8, quickSort3To8)
+REGISTER_FLOAT_BENCHMARK(BM_FloatSort, StdSort, stdSortFloats<float>)
+REGISTER_FLOAT_BENCHMARK(BM_DoubleSort, MergeSort3To8, mergeSort3To8)
+REGISTER_FLOAT_BENCHMARK(BM_DoubleSort, QuickSort3To8, quickSort3To8)
+REGISTER_FLOAT_BENCHMARK(BM_DoubleSort, StdSort, stdSortFloats<double>)
+
+BENCHMARK_CAPTURE(BM_TableSort, Columnar, sortTableColumnar)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 20)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_TableSort, RowStructs, sortTableRows)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 20)
+    ->UseRealTime();
+
+BENCHMARK(BM_SegmentedSort)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK(BM_CountingSort)
+    ->Apply(countingSweep)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+BENCHMARK(BM_AsyncPipeline)
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+#define REGISTER_PIVOT_BENCHMARK(PIVOT, PARTITION, DIST)            \
+    BENCHMARK_CAPTURE(BM_Pivot, PIVOT##_##PARTITION##_##DIST, PivotSelection::PIVOT, \
+                      PartitionScheme::PARTITION, Distribution::DIST) \
+        ->RangeMultiplier(4)                                        \
+        ->Range(1 << 10, 1 << 20)                                   \
+        ->Unit(benchmark::kNanosecond)                              \
+        ->UseRealTime();
+
+// The Last pivot is quadratic, with recursion as deep as the input, on
+// sorted and patterned data, so it only runs on Random and FewUnique.
+#define REGISTER_PIVOT_BENCHMARKS(PIVOT, PARTITION)                 \
+    REGISTER_PIVOT_BENCHMARK(PIVOT, PARTITION, Random)              \
+    REGISTER_PIVOT_BENCHMARK(PIVOT, PARTITION, FewUnique)           \
+    REGISTER_PIVOT_BENCHMARK(PIVOT, PARTITION, OrganPipe)           \
+    REGISTER_PIVOT_BENCHMARK(PIVOT, PARTITION, MedianOf3Killer)
+
+#define REGISTER_PARTITION_BENCHMARKS(PARTITION)                    \
+    REGISTER_PIVOT_BENCHMARKS(MedianOfThree, PARTITION)             \
+    REGISTER_PIVOT_BENCHMARKS(MedianOf5, PARTITION)                 \
+    REGISTER_PIVOT_BENCHMARKS(Ninther, PARTITION)                   \
+    REGISTER_PIVOT_BENCHMARKS(PseudoMedianOf25, PARTITION)          \
+    REGISTER_PIVOT_BENCHMARKS(Random, PARTITION)                    \
+    REGISTER_PIVOT_BENCHMARK(Last, PARTITION, Random)               \
+    REGISTER_PIVOT_BENCHMARK(Last, PARTITION, FewUnique)
+
+REGISTER_PARTITION_BENCHMARKS(Hoare)
+REGISTER_PARTITION_BENCHMARKS(BranchlessLomuto)
+REGISTER_PARTITION_BENCHMARKS(ThreeWay)
+
+// Same as BENCHMARK_MAIN(), plus --perf_counters to report hardware counters
+// per element alongside the timings.
+int main(int argc, char** argv) {
+    int kept = 1;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--perf_counters") == 0) {
+            PerfCounters::enabled() = true;
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    argc = kept;
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
@@ -0,0 +1,171 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "../algorithms/sorting_networks.h"
+
+// Isolated cost of the small sorting networks. Each benchmark runs over a
+// pool of inputs drawn uniformly from all permutations of N elements, so the
+// branchy baselines cannot learn the sequence.
+//
+// Throughput: every input in the pool is sorted in its own buffer, so
+// consecutive sorts are independent and can overlap in the pipeline.
+// Latency: each input is offset by the minimum of the previous result (always
+// zero), which chains every sort on the one before it.
+static const unsigned kSeed = 20230607;
+static const int kPoolSize = 4096;
+
+static std::vector<int> generatePermutationPool(int n) {
+    std::vector<std::vector<int>> permutations;
+    std::vector<int> perm(n);
+    std::iota(perm.begin(), perm.end(), 0);
+    do {
+        permutations.push_back(perm);
+    } while (std::next_permutation(perm.begin(), perm.end()));
+
+    std::vector<int> pool;
+    pool.reserve(kPoolSize * n);
+    std::mt19937 gen(kSeed);
+    std::uniform_int_distribution<size_t> dis(0, permutations.size() - 1);
+    for (int i = 0; i < kPoolSize; i++) {
+        const auto& chosen = permutations[dis(gen)];
+        pool.insert(pool.end(), chosen.begin(), chosen.end());
+    }
+    return pool;
+}
+
+template<int N>
+static void insertionSort(int* buffer) {
+    for (int i = 1; i < N; i++) {
+        int value = buffer[i];
+        int j = i - 1;
+        while (j >= 0 && buffer[j] > value) {
+            buffer[j + 1] = buffer[j];
+            j--;
+        }
+        buffer[j + 1] = value;
+    }
+}
+
+template<int N>
+static void stdSort(int* buffer) {
+    std::sort(buffer, buffer + N);
+}
+
+// Size-optimal networks written with std::min/std::max, leaving instruction
+// selection to the compiler.
+static inline void minMax(int* buffer, int a, int b) {
+    int x = buffer[a];
+    int y = buffer[b];
+    buffer[a] = std::min(x, y);
+    buffer[b] = std::max(x, y);
+}
+
+static void Sort3MinMax(int* b) {
+    minMax(b, 0, 2); minMax(b, 0, 1); minMax(b, 1, 2);
+}
+
+static void Sort4MinMax(int* b) {
+    minMax(b, 0, 2); minMax(b, 1, 3);
+    minMax(b, 0, 1); minMax(b, 2, 3);
+    minMax(b, 1, 2);
+}
+
+static void Sort5MinMax(int* b) {
+    minMax(b, 0, 3); minMax(b, 1, 4);
+    minMax(b, 0, 2); minMax(b, 1, 3);
+    minMax(b, 0, 1); minMax(b, 2, 4);
+    minMax(b, 1, 2); minMax(b, 3, 4);
+    minMax(b, 2, 3);
+}
+
+static void Sort6MinMax(int* b) {
+    minMax(b, 0, 5); minMax(b, 1, 3); minMax(b, 2, 4);
+    minMax(b, 1, 2); minMax(b, 3, 4);
+    minMax(b, 0, 3); minMax(b, 2, 5);
+    minMax(b, 0, 1); minMax(b, 2, 3); minMax(b, 4, 5);
+    minMax(b, 1, 2); minMax(b, 3, 4);
+}
+
+static void Sort7MinMax(int* b) {
+    minMax(b, 0, 6); minMax(b, 2, 3); minMax(b, 4, 5);
+    minMax(b, 0, 2); minMax(b, 1, 4); minMax(b, 3, 6);
+    minMax(b, 0, 1); minMax(b, 2, 5); minMax(b, 3, 4);
+    minMax(b, 1, 2); minMax(b, 4, 6);
+    minMax(b, 2, 3); minMax(b, 4, 5);
+    minMax(b, 1, 2); minMax(b, 3, 4); minMax(b, 5, 6);
+}
+
+static void Sort8MinMax(int* b) {
+    minMax(b, 0, 2); minMax(b, 1, 3); minMax(b, 4, 6); minMax(b, 5, 7);
+    minMax(b, 0, 4); minMax(b, 1, 5); minMax(b, 2, 6); minMax(b, 3, 7);
+    minMax(b, 0, 1); minMax(b, 2, 3); minMax(b, 4, 5); minMax(b, 6, 7);
+    minMax(b, 2, 4); minMax(b, 3, 5);
+    minMax(b, 1, 4); minMax(b, 3, 6);
+    minMax(b, 1, 2); minMax(b, 3, 4); minMax(b, 5, 6);
+}
+
+// VarSort networks take the element count in buffer[0] followed by the
+// elements; Offset is 1 for them and 0 for everything else.
+template<int N, void (*Sort)(int*), int Offset>
+static void BM_Throughput(benchmark::State& state) {
+    const std::vector<int> pool = generatePermutationPool(N);
+    const int stride = N + Offset;
+    std::vector<int> work(kPoolSize * stride);
+    for (auto _ : state) {
+        for (int i = 0; i < kPoolSize; i++) {
+            int* buffer = &work[i * stride];
+            if (Offset) buffer[0] = N;
+            std::memcpy(buffer + Offset, &pool[i * N], N * sizeof(int));
+        }
+        for (int i = 0; i < kPoolSize; i++) {
+            Sort(&work[i * stride]);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * kPoolSize);
+}
+
+template<int N, void (*Sort)(int*), int Offset>
+static void BM_Latency(benchmark::State& state) {
+    const std::vector<int> pool = generatePermutationPool(N);
+    int buffer[N + Offset];
+    int carry = 0;
+    for (auto _ : state) {
+        for (int i = 0; i < kPoolSize; i++) {
+            if (Offset) buffer[0] = N;
+            for (int k = 0; k < N; k++) {
+                buffer[Offset + k] = pool[i * N + k] + carry;
+            }
+            Sort(buffer);
+            carry = buffer[Offset];
+        }
+        benchmark::DoNotOptimize(carry);
+    }
+    state.SetItemsProcessed(state.iterations() * kPoolSize);
+}
+
+#define REGISTER_NETWORK_BENCHMARK(N, FUNC, OFFSET)                 \
+    BENCHMARK_TEMPLATE(BM_Throughput, N, FUNC, OFFSET);             \
+    BENCHMARK_TEMPLATE(BM_Latency, N, FUNC, OFFSET);
+
+#define REGISTER_SIZE_BENCHMARKS(N)                                 \
+    REGISTER_NETWORK_BENCHMARK(N, Sort##N##AlphaDev, 0)             \
+    REGISTER_NETWORK_BENCHMARK(N, Sort##N##MinMax, 0)               \
+    REGISTER_NETWORK_BENCHMARK(N, insertionSort<N>, 0)              \
+    REGISTER_NETWORK_BENCHMARK(N, stdSort<N>, 0)
+
+REGISTER_SIZE_BENCHMARKS(3)
+REGISTER_SIZE_BENCHMARKS(4)
+REGISTER_SIZE_BENCHMARKS(5)
+REGISTER_SIZE_BENCHMARKS(6)
+REGISTER_SIZE_BENCHMARKS(7)
+REGISTER_SIZE_BENCHMARKS(8)
+
+REGISTER_NETWORK_BENCHMARK(3, VarSort3AlphaDev, 1)
+REGISTER_NETWORK_BENCHMARK(4, VarSort4AlphaDev, 1)
+REGISTER_NETWORK_BENCHMARK(5, VarSort5AlphaDev, 1)
+
+BENCHMARK_MAIN();
@@ -0,0 +1,357 @@
+// Compares Google Benchmark CSV/JSON outputs of the :benchmark target.
+//
+//   compare_benchmarks [--threshold=0.05] [--alpha=0.05] [--metric=real_time]
+//                      baseline.{csv,json} candidate.{csv,json} [...]
+//
+// Every candidate is matched against the baseline by benchmark name (which
+// includes the input size). Individual repetitions are used as samples, so
+// run the benchmark with --benchmark_repetitions=N (N >= 5 is useful).
+// Aggregate rows (_mean, _median, ...) are ignored.
+//
+// For each match the tool prints the median speedup (baseline / candidate
+// time) with a 95% bootstrap confidence interval and the two-sided
+// Mann-Whitney U p-value. A benchmark is flagged as a regression when it is
+// slower by more than the threshold and the difference is significant at
+// alpha; the exit status is 1 if any regression was found.
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using Samples = std::map<std::string, std::vector<double>>;
+
+static double toNanoseconds(double value, const std::string& unit) {
+    if (unit == "us") return value * 1e3;
+    if (unit == "ms") return value * 1e6;
+    if (unit == "s") return value * 1e9;
+    return value;
+}
+
+static bool isAggregateName(const std::string& name) {
+    for (const char* suffix : {"_mean", "_median", "_stddev", "_cv"}) {
+        size_t len = std::strlen(suffix);
+        if (name.size() >= len && name.compare(name.size() - len, len, suffix) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static std::vector<std::string> splitCsvLine(const std::string& line) {
+    std::vector<std::string> fields;
+    std::string field;
+    bool quoted = false;
+    for (size_t i = 0; i < line.size(); i++) {
+        char c = line[i];
+        if (quoted) {
+            if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                field += '"';
+                i++;
+            } else if (c == '"') {
+                quoted = false;
+            } else {
+                field += c;
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            fields.push_back(field);
+            field.clear();
+        } else {
+            field += c;
+        }
+    }
+    fields.push_back(field);
+    return fields;
+}
+
+static bool loadCsv(std::istream& in, const std::string& metric, Samples& samples) {
+    std::string line;
+    std::vector<std::string> header;
+    while (std::getline(in, line)) {
+        if (line.compare(0, 5, "name,") == 0) {
+            header = splitCsvLine(line);
+            break;
+        }
+    }
+    auto column = [&header](const std::string& name) {
+        return std::find(header.begin(), header.end(), name) - header.begin();
+    };
+    size_t nameCol = column("name");
+    size_t metricCol = column(metric);
+    size_t unitCol = column("time_unit");
+    size_t errorCol = column("error_occurred");
+    if (header.empty() || metricCol == header.size() || unitCol == header.size()) {
+        return false;
+    }
+
+    while (std::getline(in, line)) {
+        std::vector<std::string> fields = splitCsvLine(line);
+        if (fields.size() < header.size()) continue;
+        if (errorCol < fields.size() && fields[errorCol] == "true") continue;
+        const std::string& name = fields[nameCol];
+        if (isAggregateName(name)) continue;
+        samples[name].push_back(toNanoseconds(std::atof(fields[metricCol].c_str()), fields[unitCol]));
+    }
+    return true;
+}
+
+// Just enough JSON to read the flat objects of the "benchmarks" array.
+class JsonReader {
+public:
+    explicit JsonReader(const std::string& text) : text_(text) {}
+
+    bool readBenchmarks(std::vector<std::map<std::string, std::string>>& out) {
+        size_t key = text_.find("\"benchmarks\"");
+        if (key == std::string::npos) return false;
+        pos_ = text_.find('[', key);
+        if (pos_ == std::string::npos) return false;
+        pos_++;
+        while (true) {
+            skipSpace();
+            if (peek() == ']') return true;
+            if (peek() == ',') { pos_++; continue; }
+            if (peek() != '{') return false;
+            std::map<std::string, std::string> object;
+            if (!readObject(object)) return false;
+            out.push_back(object);
+        }
+    }
+
+private:
+    const std::string& text_;
+    size_t pos_ = 0;
+
+    char peek() const { return pos_ < text_.size() ? text_[pos_] : '\0'; }
+
+    void skipSpace() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) pos_++;
+    }
+
+    bool readString(std::string& out) {
+        if (peek() != '"') return false;
+        pos_++;
+        while (pos_ < text_.size() && text_[pos_] != '"') {
+            if (text_[pos_] == '\\' && pos_ + 1 < text_.size()) pos_++;
+            out += text_[pos_++];
+        }
+        pos_++;
+        return pos_ <= text_.size();
+    }
+
+    // Scalars are returned as their literal text; nested values are skipped.
+    bool readValue(std::string& out) {
+        skipSpace();
+        if (peek() == '"') return readString(out);
+        if (peek() == '{' || peek() == '[') {
+            int depth = 0;
+            bool inString = false;
+            for (; pos_ < text_.size(); pos_++) {
+                char c = text_[pos_];
+                if (inString) {
+                    if (c == '\\') pos_++;
+                    else if (c == '"') inString = false;
+                } else if (c == '"') {
+                    inString = true;
+                } else if (c == '{' || c == '[') {
+                    depth++;
+                } else if (c == '}' || c == ']') {
+                    if (--depth == 0) { pos_++; return true; }
+                }
+            }
+            return false;
+        }
+        while (pos_ < text_.size() && text_[pos_] != ',' && text_[pos_] != '}' &&
+               !std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+            out += text_[pos_++];
+        }
+        return !out.empty();
+    }
+
+    bool readObject(std::map<std::string, std::string>& object) {
+        pos_++;
+        while (true) {
+            skipSpace();
+            if (peek() == '}') { pos_++; return true; }
+            if (peek() == ',') { pos_++; continue; }
+            std::string key, value;
+            if (!readString(key)) return false;
+            skipSpace();
+            if (peek() != ':') return false;
+            pos_++;
+            if (!readValue(value)) return false;
+            object[key] = value;
+        }
+    }
+};
+
+static bool loadJson(std::istream& in, const std::string& metric, Samples& samples) {
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    std::string text = buffer.str();
+    std::vector<std::map<std::string, std::string>> benchmarks;
+    if (!JsonReader(text).readBenchmarks(benchmarks)) return false;
+
+    for (auto& benchmark : benchmarks) {
+        if (benchmark["run_type"] == "aggregate" || benchmark.count("error_occurred")) continue;
+        if (!benchmark.count(metric)) continue;
+        const std::string& name = benchmark["name"];
+        if (isAggregateName(name)) continue;
+        samples[name].push_back(toNanoseconds(std::atof(benchmark[metric].c_str()), benchmark["time_unit"]));
+    }
+    return true;
+}
+
+static bool loadResults(const std::string& path, const std::string& metric, Samples& samples) {
+    std::ifstream in(path);
+    if (!in) return false;
+    bool isJson = path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0;
+    return isJson ? loadJson(in, metric, samples) : loadCsv(in, metric, samples);
+}
+
+static double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    size_t n = values.size();
+    return n % 2 ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2;
+}
+
+// Two-sided p-value of the Mann-Whitney U test, normal approximation with
+// tie correction.
+static double mannWhitneyPValue(const std::vector<double>& a, const std::vector<double>& b) {
+    std::vector<std::pair<double, int>> all;
+    for (double v : a) all.push_back({v, 0});
+    for (double v : b) all.push_back({v, 1});
+    std::sort(all.begin(), all.end());
+
+    double n1 = a.size();
+    double n2 = b.size();
+    double n = n1 + n2;
+    double rankSumA = 0;
+    double tieTerm = 0;
+    for (size_t i = 0; i < all.size();) {
+        size_t j = i;
+        while (j < all.size() && all[j].first == all[i].first) j++;
+        double rank = (i + 1 + j) / 2.0;
+        for (size_t k = i; k < j; k++) {
+            if (all[k].second == 0) rankSumA += rank;
+        }
+        double t = j - i;
+        tieTerm += t * t * t - t;
+        i = j;
+    }
+
+    double u = rankSumA - n1 * (n1 + 1) / 2;
+    double mean = n1 * n2 / 2;
+    double variance = n1 * n2 / 12 * ((n + 1) - tieTerm / (n * (n - 1)));
+    if (variance <= 0) return 1.0;
+    double z = (std::fabs(u - mean) - 0.5) / std::sqrt(variance);
+    if (z < 0) z = 0;
+    return std::erfc(z / std::sqrt(2.0));
+}
+
+// 95% percentile bootstrap interval of median(baseline) / median(candidate).
+static void bootstrapSpeedup(const std::vector<double>& baseline, const std::vector<double>& candidate,
+                             double& low, double& high) {
+    const int kResamples = 2000;
+    std::mt19937 gen(20230607);
+    std::vector<double> ratios;
+    ratios.reserve(kResamples);
+    std::vector<double> a(baseline.size()), b(candidate.size());
+    std::uniform_int_distribution<size_t> pickA(0, baseline.size() - 1);
+    std::uniform_int_distribution<size_t> pickB(0, candidate.size() - 1);
+    for (int r = 0; r < kResamples; r++) {
+        for (double& v : a) v = baseline[pickA(gen)];
+        for (double& v : b) v = candidate[pickB(gen)];
+        ratios.push_back(median(a) / median(b));
+    }
+    std::sort(ratios.begin(), ratios.end());
+    low = ratios[kResamples * 25 / 1000];
+    high = ratios[kResamples * 975 / 1000 - 1];
+}
+
+static int compare(const std::string& baselinePath, const Samples& baseline,
+                   const std::string& candidatePath, const Samples& candidate,
+                   double threshold, double alpha) {
+    std::printf("\n%s -> %s\n", baselinePath.c_str(), candidatePath.c_str());
+    std::printf("%-60s %12s %12s %8s %17s %8s\n",
+                "Benchmark", "Base(ns)", "New(ns)", "Speedup", "95% CI", "p");
+
+    int regressions = 0;
+    for (const auto& [name, base] : baseline) {
+        auto it = candidate.find(name);
+        if (it == candidate.end()) continue;
+        const std::vector<double>& cand = it->second;
+
+        double baseMedian = median(base);
+        double candMedian = median(cand);
+        double speedup = baseMedian / candMedian;
+        double low = speedup, high = speedup;
+        double p = 1.0;
+        if (base.size() > 1 && cand.size() > 1) {
+            bootstrapSpeedup(base, cand, low, high);
+            p = mannWhitneyPValue(base, cand);
+        }
+
+        const char* verdict = "";
+        if (p < alpha && speedup < 1.0 / (1.0 + threshold)) {
+            verdict = "REGRESSION";
+            regressions++;
+        } else if (p < alpha && speedup > 1.0 + threshold) {
+            verdict = "faster";
+        }
+        std::printf("%-60s %12.0f %12.0f %7.3fx [%6.3f, %6.3f] %8.4f %s\n",
+                    name.c_str(), baseMedian, candMedian, speedup, low, high, p, verdict);
+    }
+    return regressions;
+}
+
+int main(int argc, char** argv) {
+    double threshold = 0.05;
+    double alpha = 0.05;
+    std::string metric = "real_time";
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.compare(0, 12, "--threshold=") == 0) {
+            threshold = std::atof(arg.c_str() + 12);
+        } else if (arg.compare(0, 8, "--alpha=") == 0) {
+            alpha = std::atof(arg.c_str() + 8);
+        } else if (arg.compare(0, 9, "--metric=") == 0) {
+            metric = arg.substr(9);
+        } else {
+            paths.push_back(arg);
+        }
+    }
+    if (paths.size() < 2) {
+        std::fprintf(stderr, "usage: %s [--threshold=0.05] [--alpha=0.05] [--metric=real_time|cpu_time] "
+                             "baseline candidate [candidate...]\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<Samples> results(paths.size());
+    for (size_t i = 0; i < paths.size(); i++) {
+        if (!loadResults(paths[i], metric, results[i])) {
+            std::fprintf(stderr, "could not read %s results from %s\n", metric.c_str(), paths[i].c_str());
+            return 2;
+        }
+    }
+
+    int regressions = 0;
+    for (size_t i = 1; i < paths.size(); i++) {
+        regressions += compare(paths[0], results[0], paths[i], results[i], threshold, alpha);
+    }
+    if (regressions > 0) {
+        std::printf("\n%d regression(s) above %.1f%%\n", regressions, threshold * 100);
+        return 1;
+    }
+    return 0;
+}
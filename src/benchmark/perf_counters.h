@@ -0,0 +1,121 @@
+#ifndef PERF_COUNTERS_H_
+#define PERF_COUNTERS_H_
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Hardware counters read around the timed region of a benchmark and reported
+// per element as user counters. Counters the kernel refuses to open (no PMU,
+// perf_event_paranoid, containers) are skipped; if none can be opened the
+// benchmark runs without them.
+class PerfCounters {
+public:
+    static bool& enabled() {
+        static bool flag = false;
+        return flag;
+    }
+
+    PerfCounters() {
+        if (!enabled()) return;
+#ifdef __linux__
+        open(0, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, "instructions");
+        open(1, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, "cycles");
+        open(2, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, "branch_misses");
+        open(3, PERF_TYPE_HW_CACHE,
+             PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                 (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+             "l1d_misses");
+        open(4, PERF_TYPE_HW_CACHE,
+             PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                 (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+             "llc_misses");
+        warnIfUnavailable();
+#endif
+    }
+
+    ~PerfCounters() {
+#ifdef __linux__
+        for (int i = 0; i < kNumCounters; i++) {
+            if (fds_[i] >= 0) close(fds_[i]);
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    void start() {
+#ifdef __linux__
+        for (int i = 0; i < kNumCounters; i++) {
+            if (fds_[i] < 0) continue;
+            ioctl(fds_[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(fds_[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    void stop() {
+#ifdef __linux__
+        for (int i = 0; i < kNumCounters; i++) {
+            if (fds_[i] < 0) continue;
+            ioctl(fds_[i], PERF_EVENT_IOC_DISABLE, 0);
+            uint64_t value = 0;
+            if (read(fds_[i], &value, sizeof(value)) == sizeof(value)) {
+                values_[i] = value;
+            }
+        }
+#endif
+    }
+
+    void report(benchmark::State& state, double elements) const {
+        if (elements <= 0) return;
+        for (int i = 0; i < kNumCounters; i++) {
+            if (fds_[i] < 0) continue;
+            state.counters[std::string(names_[i]) + "_per_elem"] = values_[i] / elements;
+        }
+    }
+
+private:
+    static const int kNumCounters = 5;
+    int fds_[kNumCounters] = {-1, -1, -1, -1, -1};
+    uint64_t values_[kNumCounters] = {};
+    const char* names_[kNumCounters] = {};
+
+#ifdef __linux__
+    void open(int slot, uint32_t type, uint64_t config, const char* name) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        names_[slot] = name;
+        fds_[slot] = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+
+    void warnIfUnavailable() const {
+        static bool warned = false;
+        if (warned) return;
+        for (int i = 0; i < kNumCounters; i++) {
+            if (fds_[i] < 0) {
+                std::fprintf(stderr, "perf counter %s unavailable, not reported\n", names_[i]);
+            }
+        }
+        warned = true;
+    }
+#endif
+};
+
+#endif
@@ -0,0 +1,102 @@
+#include "../algorithms/adaptive_sort.h"
+#include <vector>
+#include <algorithm>
+#include <string>
+#include "gtest/gtest.h"
+
+static std::vector<SortProfile> recorded;
+
+static void recordDecision(const SortProfile& profile) {
+    recorded.push_back(profile);
+}
+
+static std::vector<int> randomValues(int size, int range) {
+    std::vector<int> values(size);
+    for (int& value : values) {
+        value = rand() % range - range / 2;
+    }
+    return values;
+}
+
+static std::vector<int> nearlySorted(int size) {
+    std::vector<int> values(size);
+    for (int i = 0; i < size; ++i) {
+        values[i] = i * 1000;
+    }
+    for (int s = 0; s < size / 1000; ++s) {
+        std::swap(values[rand() % size], values[rand() % size]);
+    }
+    return values;
+}
+
+TEST(AdaptiveSortTest, ChoosesEngine) {
+    std::vector<int> reversed(10000);
+    for (int i = 0; i < 10000; ++i) {
+        reversed[i] = -i * 7;
+    }
+    std::vector<int> fewWide = randomValues(100000, 8);
+    for (int& value : fewWide) {
+        value *= 100000000;
+    }
+    struct Case {
+        const char* name;
+        std::vector<int> values;
+        SortEngine engine;
+    };
+    std::vector<Case> cases = {
+        {"tiny", randomValues(8, 1000), SortEngine::Network},
+        {"small", randomValues(200, 1000), SortEngine::QuickSort},
+        {"random", randomValues(100000, 1 << 30), SortEngine::QuickSort},
+        {"nearlySorted", nearlySorted(100000), SortEngine::NaturalMerge},
+        {"reversed", reversed, SortEngine::NaturalMerge},
+        {"smallRange", randomValues(100000, 1000), SortEngine::CountingSort},
+        {"fewWideValues", fewWide, SortEngine::ThreeWayQuickSort},
+    };
+    for (const Case& c : cases) {
+        SortProfile profile = profileSort(c.values.data(), c.values.size());
+        EXPECT_EQ(profile.engine, c.engine) << c.name << " chose " << sortEngineName(profile.engine);
+        EXPECT_EQ(profile.size, static_cast<int>(c.values.size()));
+    }
+}
+
+TEST(AdaptiveSortTest, SortsEveryShape) {
+    std::vector<std::vector<int>> inputs;
+    for (int size : {0, 1, 2, 3, 8, 9, 255, 256, 1000, 100000}) {
+        inputs.push_back(randomValues(size, 1 << 30));
+        inputs.push_back(randomValues(size, 16));
+        inputs.push_back(nearlySorted(size));
+        std::vector<int> descending = randomValues(size, 1 << 20);
+        std::sort(descending.rbegin(), descending.rend());
+        inputs.push_back(descending);
+    }
+    for (std::vector<int>& input : inputs) {
+        SCOPED_TRACE("size=" + std::to_string(input.size()));
+        std::vector<int> expected = input;
+        std::sort(expected.begin(), expected.end());
+        sort(input.data(), input.size());
+        ASSERT_EQ(input, expected);
+    }
+}
+
+TEST(AdaptiveSortTest, HookSeesDecisions) {
+    recorded.clear();
+    setSortDecisionHook(recordDecision);
+    std::vector<int> values = randomValues(5000, 100);
+    sort(values.data(), values.size());
+    std::vector<int> tiny = {3, 1, 2};
+    sort(tiny.data(), tiny.size());
+    setSortDecisionHook(nullptr);
+    sort(values.data(), values.size());
+
+    ASSERT_EQ(recorded.size(), 2u);
+    EXPECT_EQ(recorded[0].engine, SortEngine::CountingSort);
+    EXPECT_EQ(recorded[0].valueRange, recorded[0].maxValue - int64_t(recorded[0].minValue) + 1);
+    EXPECT_LE(recorded[0].valueRange, 100);
+    EXPECT_EQ(recorded[1].engine, SortEngine::Network);
+    EXPECT_EQ(tiny, (std::vector<int>{1, 2, 3}));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,179 @@
+#include "../algorithms/async_sort.h"
+#include "../algorithms/quick_sort_variants.h"
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include "gtest/gtest.h"
+
+// Sort functions are plain function pointers, so the instrumented ones below
+// report through globals.
+static std::atomic<bool> gStarted{false};
+static std::atomic<bool> gReleased{false};
+static std::atomic<int> gRunning{0};
+static std::atomic<int> gMaxRunning{0};
+
+static void blockingSort(int* arr, int size) {
+    gStarted = true;
+    while (!gReleased) {
+        std::this_thread::yield();
+    }
+    quickSort3To8(arr, size);
+}
+
+static void countingSort(int* arr, int size) {
+    int now = ++gRunning;
+    int seen = gMaxRunning;
+    while (now > seen && !gMaxRunning.compare_exchange_weak(seen, now)) {
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    quickSort3To8(arr, size);
+    --gRunning;
+}
+
+static void throwingSort(int*, int) {
+    throw std::runtime_error("sort failed");
+}
+
+static std::vector<int> randomVector(int size) {
+    std::vector<int> values(size);
+    for (int& value : values) {
+        value = rand();
+    }
+    return values;
+}
+
+TEST(AsyncSortTest, SortsEveryBuffer) {
+    SortThreadPool pool(4);
+    std::vector<std::vector<int>> buffers;
+    for (int size : {0, 1, 7, 100, 10000, 100000}) {
+        buffers.push_back(randomVector(size));
+    }
+    std::vector<SortHandle> handles;
+    for (std::vector<int>& buffer : buffers) {
+        handles.push_back(pool.submit(quickSort3To8, buffer.data(), buffer.size()));
+    }
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        EXPECT_EQ(handles[i].wait(), SortStatus::Completed);
+        EXPECT_TRUE(std::is_sorted(buffers[i].begin(), buffers[i].end()));
+    }
+}
+
+TEST(AsyncSortTest, CallbackRunsBeforeFutureIsReady) {
+    SortThreadPool pool(2);
+    std::vector<int> buffer = randomVector(5000);
+    bool sortedInCallback = false;
+    SortStatus reported = SortStatus::Cancelled;
+    SortHandle handle = pool.submit(quickSort3To8, buffer.data(), buffer.size(), [&](SortStatus status) {
+        reported = status;
+        sortedInCallback = std::is_sorted(buffer.begin(), buffer.end());
+    });
+    EXPECT_EQ(handle.wait(), SortStatus::Completed);
+    EXPECT_EQ(reported, SortStatus::Completed);
+    EXPECT_TRUE(sortedInCallback);
+}
+
+TEST(AsyncSortTest, CancelsOnlyQueuedJobs) {
+    gReleased = false;
+    SortThreadPool pool(1);
+    std::vector<int> first = randomVector(1000);
+    std::vector<int> second = randomVector(1000);
+    const std::vector<int> secondOriginal = second;
+    int cancelledCallbacks = 0;
+
+    SortHandle running = pool.submit(blockingSort, first.data(), first.size());
+    SortHandle queued = pool.submit(quickSort3To8, second.data(), second.size(), [&](SortStatus status) {
+        cancelledCallbacks += status == SortStatus::Cancelled;
+    });
+
+    EXPECT_TRUE(queued.cancel());
+    EXPECT_FALSE(queued.cancel());
+    EXPECT_EQ(queued.wait(), SortStatus::Cancelled);
+    EXPECT_EQ(cancelledCallbacks, 1);
+
+    gReleased = true;
+    EXPECT_EQ(running.wait(), SortStatus::Completed);
+    EXPECT_FALSE(running.cancel());
+    EXPECT_TRUE(std::is_sorted(first.begin(), first.end()));
+    EXPECT_EQ(second, secondOriginal);
+}
+
+TEST(AsyncSortTest, HonoursConcurrencyLimit) {
+    for (int limit : {1, 2, 3}) {
+        gRunning = 0;
+        gMaxRunning = 0;
+        SortThreadPool pool(4);
+        pool.setConcurrencyLimit(limit);
+        std::vector<std::vector<int>> buffers(24, randomVector(256));
+        std::vector<SortHandle> handles;
+        for (std::vector<int>& buffer : buffers) {
+            handles.push_back(pool.submit(countingSort, buffer.data(), buffer.size()));
+        }
+        for (SortHandle& handle : handles) {
+            handle.wait();
+        }
+        EXPECT_LE(gMaxRunning.load(), limit);
+        for (const std::vector<int>& buffer : buffers) {
+            EXPECT_TRUE(std::is_sorted(buffer.begin(), buffer.end()));
+        }
+    }
+}
+
+TEST(AsyncSortTest, DestructorCancelsQueuedJobs) {
+    gStarted = false;
+    gReleased = false;
+    std::vector<int> first = randomVector(100);
+    std::vector<int> second = randomVector(100);
+    SortHandle running, queued;
+    {
+        SortThreadPool pool(1);
+        running = pool.submit(blockingSort, first.data(), first.size());
+        queued = pool.submit(blockingSort, second.data(), second.size());
+        while (!gStarted) {
+            std::this_thread::yield();
+        }
+        std::thread releaser([] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            gReleased = true;
+        });
+        releaser.detach();
+    }
+    EXPECT_EQ(running.wait(), SortStatus::Completed);
+    EXPECT_EQ(queued.wait(), SortStatus::Cancelled);
+}
+
+TEST(AsyncSortTest, PropagatesExceptions) {
+    SortThreadPool pool(1);
+    int value = 0;
+    std::vector<SortStatus> statuses;
+    SortHandle handle = pool.submit(throwingSort, &value, 1, [&](SortStatus status) {
+        statuses.push_back(status);
+    });
+    EXPECT_THROW(handle.wait(), std::runtime_error);
+    EXPECT_EQ(statuses, std::vector<SortStatus>{SortStatus::Failed});
+
+    SortHandle callbackThrows = pool.submit(quickSort3To8, &value, 1, [](SortStatus) {
+        throw std::logic_error("callback");
+    });
+    EXPECT_THROW(callbackThrows.wait(), std::logic_error);
+    std::vector<int> buffer = randomVector(1000);
+    EXPECT_EQ(pool.submit(quickSort3To8, buffer.data(), buffer.size()).wait(), SortStatus::Completed);
+}
+
+TEST(AsyncSortTest, EmptyHandle) {
+    SortHandle handle;
+    EXPECT_EQ(handle.wait(), SortStatus::Cancelled);
+    EXPECT_FALSE(handle.cancel());
+}
+
+TEST(AsyncSortTest, SharedPool) {
+    std::vector<int> buffer = randomVector(20000);
+    EXPECT_EQ(sortAsync(quickSort3To8, buffer.data(), buffer.size()).wait(), SortStatus::Completed);
+    EXPECT_TRUE(std::is_sorted(buffer.begin(), buffer.end()));
+    EXPECT_GE(SortThreadPool::shared().threadCount(), 1);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,77 @@
+#include "../algorithms/columnar_sort.h"
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include <numeric>
+#include <string>
+#include "gtest/gtest.h"
+
+static std::vector<int> randomColumn(int rows, int range) {
+    std::vector<int> column(rows);
+    for (int& value : column) {
+        value = rand() % range - range / 2;
+    }
+    return column;
+}
+
+static std::vector<int> referenceOrder(const std::vector<std::vector<int>>& keys, int rows) {
+    std::vector<int> order(rows);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        for (const std::vector<int>& key : keys) {
+            if (key[a] != key[b]) return key[a] < key[b];
+        }
+        return false;
+    });
+    return order;
+}
+
+TEST(ColumnarSortTest, RowOrderMatchesStableLexicographicSort) {
+    for (int rows : {0, 1, 7, 1000, 50000}) {
+        for (int keyCount : {1, 2, 3}) {
+            SCOPED_TRACE("rows=" + std::to_string(rows) + ", keys=" + std::to_string(keyCount));
+            // Low-cardinality leading keys produce long tie ranges.
+            std::vector<std::vector<int>> keys;
+            for (int k = 0; k < keyCount; ++k) {
+                keys.push_back(randomColumn(rows, k + 1 < keyCount ? 4 : 1000));
+            }
+            std::vector<const int*> keyPointers;
+            for (const std::vector<int>& key : keys) keyPointers.push_back(key.data());
+
+            ASSERT_EQ(sortedRowOrder(keyPointers.data(), keyCount, rows), referenceOrder(keys, rows));
+        }
+    }
+}
+
+TEST(ColumnarSortTest, ExtremeKeys) {
+    std::vector<int> key = {INT_MAX, 0, INT_MIN, -1, 1, INT_MIN, INT_MAX};
+    const int* keys[] = {key.data()};
+    std::vector<int> expected = {2, 5, 3, 1, 4, 0, 6};
+    ASSERT_EQ(sortedRowOrder(keys, 1, key.size()), expected);
+}
+
+TEST(ColumnarSortTest, SortTablePermutesAllColumns) {
+    const int rows = 20000;
+    std::vector<int> a = randomColumn(rows, 10);
+    std::vector<int> b = randomColumn(rows, 100000);
+    std::vector<int> payload(rows);
+    std::iota(payload.begin(), payload.end(), 0);
+    std::vector<int> original = payload;
+    std::vector<int> expected = referenceOrder({a, b}, rows);
+    std::vector<int> originalA = a, originalB = b;
+
+    int* keys[] = {a.data(), b.data()};
+    int* payloads[] = {payload.data()};
+    sortTable(keys, 2, payloads, 1, rows);
+
+    for (int i = 0; i < rows; ++i) {
+        ASSERT_EQ(payload[i], expected[i]);
+        ASSERT_EQ(a[i], originalA[expected[i]]);
+        ASSERT_EQ(b[i], originalB[expected[i]]);
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
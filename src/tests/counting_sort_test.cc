@@ -0,0 +1,73 @@
+#include "../algorithms/counting_sort.h"
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include <string>
+#include "gtest/gtest.h"
+
+static std::vector<int> randomValues(int size, int64_t low, int64_t high) {
+    std::vector<int> values(size);
+    uint64_t span = high - low + 1;
+    for (int& value : values) {
+        uint64_t r = (uint64_t(rand()) << 31) ^ rand();
+        value = static_cast<int>(low + int64_t(r % span));
+    }
+    return values;
+}
+
+TEST(CountingSortTest, FindRange) {
+    for (int size : {1, 7, 8, 9, 100, 1001}) {
+        std::vector<int> values = randomValues(size, INT_MIN, INT_MAX);
+        int low, high;
+        findRange(values.data(), size, &low, &high);
+        EXPECT_EQ(low, *std::min_element(values.begin(), values.end()));
+        EXPECT_EQ(high, *std::max_element(values.begin(), values.end()));
+    }
+}
+
+TEST(CountingSortTest, Decision) {
+    EXPECT_TRUE(shouldUseCountingSort(1000, -500, 7499));
+    EXPECT_FALSE(shouldUseCountingSort(1000, -500, 7500));
+    EXPECT_FALSE(shouldUseCountingSort(100, 0, 0));
+    EXPECT_FALSE(shouldUseCountingSort(1000, INT_MIN, INT_MAX));
+}
+
+TEST(CountingSortTest, SortsSmallAndBlockedRanges) {
+    // Spans below and well above an L2-sized histogram, including the full
+    // int range, exercise both the direct and the blocked histogram.
+    const int64_t spans[] = {1, 2, 100, 1 << 16, 1 << 22, int64_t(1) << 32};
+    for (int64_t span : spans) {
+        for (int size : {0, 1, 2, 1000, 200000}) {
+            SCOPED_TRACE("span=" + std::to_string(span) + ", size=" + std::to_string(size));
+            int64_t low = span == (int64_t(1) << 32) ? INT_MIN : -span / 3;
+            std::vector<int> values = randomValues(size, low, low + span - 1);
+            std::vector<int> expected = values;
+            std::sort(expected.begin(), expected.end());
+            if (size > 0) {
+                int minValue, maxValue;
+                findRange(values.data(), size, &minValue, &maxValue);
+                countingSort(values.data(), size, minValue, maxValue);
+            }
+            ASSERT_EQ(values, expected);
+        }
+    }
+}
+
+TEST(CountingSortTest, AdaptiveMatchesStdSort) {
+    for (int64_t span : {int64_t(10), int64_t(2000001), int64_t(1) << 32}) {
+        for (int size : {0, 1, 5, 255, 256, 100000, 1 << 20}) {
+            SCOPED_TRACE("span=" + std::to_string(span) + ", size=" + std::to_string(size));
+            int64_t low = span == (int64_t(1) << 32) ? INT_MIN : -span / 2;
+            std::vector<int> values = randomValues(size, low, low + span - 1);
+            std::vector<int> expected = values;
+            std::sort(expected.begin(), expected.end());
+            countingSort3To8(values.data(), size);
+            ASSERT_EQ(values, expected);
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,96 @@
+#include "../algorithms/float_sort.h"
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <string>
+#include "gtest/gtest.h"
+
+template<typename Float>
+static std::vector<Float> specialValues() {
+    using Limits = std::numeric_limits<Float>;
+    return {Float(0.0), Float(-0.0), Limits::infinity(), -Limits::infinity(), Limits::quiet_NaN(),
+            -Limits::quiet_NaN(), Limits::denorm_min(), -Limits::denorm_min(), Limits::min(), Limits::lowest(),
+            Limits::max(), Float(1.5), Float(-1.5)};
+}
+
+template<typename Float>
+static std::vector<Float> randomValues(int size) {
+    std::vector<Float> values = specialValues<Float>();
+    while (static_cast<int>(values.size()) < size) {
+        Float value = static_cast<Float>(rand() - RAND_MAX / 2) / static_cast<Float>(rand() % 1000 + 1);
+        values.push_back(value);
+    }
+    std::shuffle(values.begin(), values.end(), std::mt19937(size));
+    return values;
+}
+
+// Checks non-NaN values are ascending with -0.0 before +0.0, that every NaN
+// is at the end, and that the values are a permutation of the input.
+template<typename Float>
+static void expectTotalOrder(const std::vector<Float>& input, const std::vector<Float>& sorted) {
+    ASSERT_EQ(input.size(), sorted.size());
+    int nanCount = std::count_if(input.begin(), input.end(), [](Float v) { return std::isnan(v); });
+    int firstNaN = sorted.size() - nanCount;
+    for (int i = firstNaN; i < static_cast<int>(sorted.size()); ++i) {
+        ASSERT_TRUE(std::isnan(sorted[i])) << "position " << i;
+    }
+    for (int i = 1; i < firstNaN; ++i) {
+        ASSERT_LE(sorted[i - 1], sorted[i]) << "position " << i;
+        if (sorted[i - 1] == 0 && sorted[i] == 0) {
+            ASSERT_FALSE(!std::signbit(sorted[i - 1]) && std::signbit(sorted[i])) << "+0.0 before -0.0";
+        }
+    }
+    std::vector<Float> expected;
+    std::copy_if(input.begin(), input.end(), std::back_inserter(expected), [](Float v) { return !std::isnan(v); });
+    std::sort(expected.begin(), expected.end());
+    for (int i = 0; i < firstNaN; ++i) {
+        ASSERT_EQ(sorted[i], expected[i]) << "position " << i;
+    }
+}
+
+template<typename Float>
+static void testFloatSort(void (*sortFunc)(Float*, int)) {
+    for (int size : {0, 1, 13, 100, 10000}) {
+        SCOPED_TRACE("size=" + std::to_string(size));
+        std::vector<Float> input = size >= 13 ? randomValues<Float>(size) : std::vector<Float>(size, Float(2.0));
+        std::vector<Float> arr = input;
+        sortFunc(arr.data(), arr.size());
+        expectTotalOrder(input, arr);
+    }
+}
+
+TEST(FloatSortTest, MergeSortFloat) {
+    testFloatSort<float>(mergeSort3To8);
+}
+
+TEST(FloatSortTest, QuickSortFloat) {
+    testFloatSort<float>(quickSort3To8);
+}
+
+TEST(FloatSortTest, MergeSortDouble) {
+    testFloatSort<double>(mergeSort3To8);
+}
+
+TEST(FloatSortTest, QuickSortDouble) {
+    testFloatSort<double>(quickSort3To8);
+}
+
+TEST(FloatSortTest, SpecialValuesExactOrder) {
+    float inf = std::numeric_limits<float>::infinity();
+    std::vector<float> arr = {0.0f, inf, -0.0f, std::nanf(""), -inf, 1.0f, -1.0f, -0.0f, 0.0f};
+    quickSort3To8(arr.data(), arr.size());
+    std::vector<float> expected = {-inf, -1.0f, -0.0f, -0.0f, 0.0f, 0.0f, 1.0f, inf};
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(arr[i], expected[i]) << "position " << i;
+        ASSERT_EQ(std::signbit(arr[i]), std::signbit(expected[i])) << "position " << i;
+    }
+    ASSERT_TRUE(std::isnan(arr.back()));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,165 @@
+#include "../algorithms/generic_sort.h"
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include <memory>
+#include <numeric>
+#include <string>
+#include "gtest/gtest.h"
+
+struct Record {
+    int key;
+    int sequence;
+    std::string name;
+};
+
+static std::vector<Record> randomRecords(int size, int keyRange) {
+    std::vector<Record> records(size);
+    for (int i = 0; i < size; ++i) {
+        records[i] = {rand() % keyRange, i, "r" + std::to_string(i)};
+    }
+    return records;
+}
+
+TEST(GenericSortTest, NetworksSortAllPermutations) {
+    // Exhaustive over permutations of 2-8 distinct values.
+    auto less = std::less<>();
+    for (int size = 2; size <= 8; ++size) {
+        std::vector<int> perm(size);
+        std::iota(perm.begin(), perm.end(), 0);
+        do {
+            std::vector<int> arr = perm;
+            generic_networks::sort(arr.data(), size, less);
+            ASSERT_TRUE(std::is_sorted(arr.begin(), arr.end())) << "size " << size;
+            arr = perm;
+            generic_networks::sortStable(arr.data(), size, less);
+            ASSERT_TRUE(std::is_sorted(arr.begin(), arr.end())) << "size " << size;
+        } while (std::next_permutation(perm.begin(), perm.end()));
+    }
+}
+
+TEST(GenericSortTest, IntAscendingAndDescending) {
+    for (int size : {0, 1, 2, 10, 1000, 10000}) {
+        SCOPED_TRACE("size=" + std::to_string(size));
+        std::vector<int> original(size);
+        for (int& value : original) {
+            value = rand() - RAND_MAX / 2;
+        }
+        if (size > 2) {
+            original[0] = INT_MIN;
+            original[1] = INT_MAX;
+        }
+        std::vector<int> ascending = original;
+        std::sort(ascending.begin(), ascending.end());
+        std::vector<int> descending = ascending;
+        std::reverse(descending.begin(), descending.end());
+
+        std::vector<int> arr = original;
+        generic::mergeSort(arr.data(), size);
+        ASSERT_EQ(arr, ascending);
+        arr = original;
+        generic::quickSort(arr.data(), size);
+        ASSERT_EQ(arr, ascending);
+        arr = original;
+        generic::mergeSort(arr.data(), size, std::greater<>());
+        ASSERT_EQ(arr, descending);
+        arr = original;
+        generic::quickSort<configs::VarSort5Config>(arr.data(), size, std::greater<int>());
+        ASSERT_EQ(arr, descending);
+    }
+}
+
+TEST(GenericSortTest, AllConfigs) {
+    std::vector<double> original(1000);
+    for (double& value : original) {
+        value = rand() / 7.0;
+    }
+    std::vector<double> expected = original;
+    std::sort(expected.begin(), expected.end());
+
+    auto check = [&](auto config) {
+        using Config = decltype(config);
+        std::vector<double> arr = original;
+        generic::mergeSort<Config>(arr.data(), arr.size());
+        ASSERT_EQ(arr, expected);
+        arr = original;
+        generic::quickSort<Config>(arr.data(), arr.size());
+        ASSERT_EQ(arr, expected);
+    };
+    check(configs::ClassicConfig());
+    check(configs::Current3To8Config());
+    check(configs::Network3Config());
+    check(configs::Networks3To4Config());
+    check(configs::Networks3To5Config());
+    check(configs::NetworksEvenConfig());
+    check(configs::NetworksOddConfig());
+    check(configs::NetworksPowerOf2Config());
+    check(configs::VarSort3Config());
+    check(configs::VarSort4Config());
+    check(configs::VarSort5Config());
+}
+
+TEST(GenericSortTest, MergeSortIsStableUnderProjection) {
+    for (int size : {5, 100, 10000}) {
+        SCOPED_TRACE("size=" + std::to_string(size));
+        std::vector<Record> records = randomRecords(size, 10);
+        generic::mergeSort(records.data(), size, std::less<>(), &Record::key);
+        for (int i = 1; i < size; ++i) {
+            ASSERT_LE(records[i - 1].key, records[i].key);
+            if (records[i - 1].key == records[i].key) {
+                ASSERT_LT(records[i - 1].sequence, records[i].sequence);
+            }
+            ASSERT_EQ(records[i].name, "r" + std::to_string(records[i].sequence));
+        }
+    }
+}
+
+TEST(GenericSortTest, QuickSortWithCustomComparator) {
+    std::vector<Record> records = randomRecords(5000, 1000);
+    auto byKeyDescendingThenName = [](const Record& a, const Record& b) {
+        return a.key != b.key ? a.key > b.key : a.name < b.name;
+    };
+    std::vector<Record> expected = records;
+    std::sort(expected.begin(), expected.end(), byKeyDescendingThenName);
+
+    generic::quickSort(records.data(), records.size(), byKeyDescendingThenName);
+    for (size_t i = 0; i < records.size(); ++i) {
+        ASSERT_EQ(records[i].sequence, expected[i].sequence);
+    }
+}
+
+TEST(GenericSortTest, LambdaProjection) {
+    std::vector<std::string> words = {"pear", "fig", "banana", "kiwi", "apple", "date", "plum", "cherry", "lime"};
+    generic::mergeSort(words.data(), words.size(), std::less<>(),
+                       [](const std::string& word) { return word.size(); });
+    std::vector<std::string> expected = {"fig", "pear", "kiwi", "date", "plum", "lime", "apple", "banana", "cherry"};
+    ASSERT_EQ(words, expected);
+}
+
+TEST(GenericSortTest, MoveOnlyElements) {
+    for (int size : {0, 1, 5, 1000}) {
+        SCOPED_TRACE("size=" + std::to_string(size));
+        std::vector<int> keys(size);
+        for (int& key : keys) {
+            key = rand() % 100;
+        }
+        std::vector<int> expected = keys;
+        std::sort(expected.begin(), expected.end());
+        auto deref = [](const std::unique_ptr<int>& p) { return *p; };
+
+        std::vector<std::unique_ptr<int>> arr;
+        for (int key : keys) arr.push_back(std::make_unique<int>(key));
+        generic::quickSort(arr.data(), size, std::less<>(), deref);
+        for (int i = 0; i < size; i++) ASSERT_EQ(*arr[i], expected[i]);
+
+        arr.clear();
+        for (int key : keys) arr.push_back(std::make_unique<int>(key));
+        generic::mergeSort(arr.data(), size, std::less<>(), deref);
+        for (int i = 0; i < size; i++) ASSERT_EQ(*arr[i], expected[i]);
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,62 @@
+#include "../algorithms/int_text.h"
+#include <climits>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+
+static bool parse(const std::string& text, std::vector<int>& out, size_t* errorOffset = nullptr) {
+    const char* errorAt = nullptr;
+    bool ok = parseIntegerLines(text.data(), text.data() + text.size(), out, &errorAt);
+    if (!ok && errorOffset) *errorOffset = errorAt - text.data();
+    return ok;
+}
+
+static std::string format(const std::vector<int>& values) {
+    std::string text(values.size() * kMaxIntegerLineChars, '\0');
+    text.resize(formatIntegerLines(values.data(), values.size(), &text[0]));
+    return text;
+}
+
+TEST(IntTextTest, ParsesLines) {
+    std::vector<int> values;
+    ASSERT_TRUE(parse("0\n-1\n+7\n123456789\n0000000000000042\n\n\r\n-2147483648\r\n2147483647", values));
+    EXPECT_EQ(values, (std::vector<int>{0, -1, 7, 123456789, 42, INT_MIN, INT_MAX}));
+}
+
+TEST(IntTextTest, RejectsMalformedLines) {
+    for (const char* line : {"x", "-", "+", "1 2", "12a", "2147483648", "-2147483649",
+                                    "99999999999999999999", " 1", "1.5", "1\r\r"}) {
+        SCOPED_TRACE(line);
+        std::vector<int> values;
+        size_t errorOffset = 0;
+        EXPECT_FALSE(parse("5\n" + std::string(line) + "\n6\n", values, &errorOffset));
+        EXPECT_EQ(values, std::vector<int>{5});
+        EXPECT_EQ(errorOffset, 2u);
+    }
+}
+
+TEST(IntTextTest, FormatsLines) {
+    EXPECT_EQ(format({0, 7, -7, 10, 99, 100, -12345, INT_MAX, INT_MIN}),
+              "0\n7\n-7\n10\n99\n100\n-12345\n2147483647\n-2147483648\n");
+    EXPECT_EQ(format({}), "");
+}
+
+TEST(IntTextTest, RoundTrip) {
+    std::vector<int> values;
+    for (int digits = 0; digits < 10; ++digits) {
+        int power = 1;
+        for (int d = 0; d < digits; ++d) power *= 10;
+        values.insert(values.end(), {power, power - 1, -power, 1 - power});
+    }
+    for (int i = 0; i < 100000; ++i) {
+        values.push_back(static_cast<int>((static_cast<unsigned>(rand()) << 16) ^ rand()));
+    }
+    std::vector<int> parsed;
+    ASSERT_TRUE(parse(format(values), parsed));
+    EXPECT_EQ(parsed, values);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
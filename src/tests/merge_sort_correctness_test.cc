@@ -1,8 +1,69 @@
 #include "../algorithms/merge_sort_variants.h"
+#include "../algorithms/cache_info.h"
+#include <string>
+#include <utility>
 #include <vector>
 #include <algorithm>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
 #include "gtest/gtest.h"
 
+// Test-only heap accounting: counts global operator new calls while enabled.
+// Kept out of line so GCC does not flag the malloc/free pairing inside
+// inlined std::allocator code.
+static bool countHeapAllocations = false;
+static size_t heapAllocations = 0;
+
+__attribute__((noinline)) void* operator new(size_t size) {
+    if (countHeapAllocations) heapAllocations++;
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+__attribute__((noinline)) void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+// std::pmr::new_delete_resource() goes through the aligned overloads.
+__attribute__((noinline)) void* operator new(size_t size, std::align_val_t alignment) {
+    if (countHeapAllocations) heapAllocations++;
+    size_t align = static_cast<size_t>(alignment);
+    if (void* ptr = std::aligned_alloc(align, (size + align - 1) / align * align)) return ptr;
+    throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void* ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+__attribute__((noinline)) void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+class CountingResource : public std::pmr::memory_resource {
+public:
+    size_t allocations = 0;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        allocations++;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
 bool isSorted(const std::vector<int>& arr) {
     for (size_t i = 1; i < arr.size(); ++i) {
         if (arr[i - 1] > arr[i]) {
@@ -12,8 +73,7 @@ bool isSorted(const std::vector<int>& arr) {
     return true;
 }
 
-template <typename SortFunc>
-void testSortCorrectness(SortFunc sortFunc, int size) {
+void testSortCorrectness(void (*sortFunc)(int*, int), int size) {
     std::vector<int> arr(size);
     for (int i = 0; i < size; ++i) {
         arr[i] = rand() % 1000;
@@ -101,6 +161,230 @@ TEST(MergeSortCorrectnessTest, VarSort5) {
     }
 }
 
+TEST(MergeSortCorrectnessTest, ScratchFromMemoryResource) {
+    CountingResource resource;
+    SortScratch scratch(&resource);
+    for (auto sortFunc : {static_cast<void (*)(int*, int, SortScratch&)>(mergeSort3To8),
+                          static_cast<void (*)(int*, int, SortScratch&)>(mergeSortVarSort5)}) {
+        for (int size : {1, 10, 1000, 10000}) {
+            std::vector<int> arr(size);
+            for (int& value : arr) {
+                value = rand() % 1000;
+            }
+            sortFunc(arr.data(), arr.size(), scratch);
+            ASSERT_TRUE(isSorted(arr)) << "Sorting failed for size " << size;
+        }
+    }
+    ASSERT_GT(resource.allocations, 0u);
+    ASSERT_GE(scratch.capacityBytes(), 5000 * sizeof(int));
+}
+
+TEST(MergeSortCorrectnessTest, RepeatedSortsDoNotAllocate) {
+    CountingResource resource;
+    SortScratch scratch(&resource);
+    std::vector<int> arr(10000);
+    for (int& value : arr) {
+        value = rand() % 1000;
+    }
+    std::vector<int> work = arr;
+    mergeSort3To8(work.data(), work.size(), scratch);
+    work = arr;
+    mergeSortNatural3To8(work.data(), work.size(), scratch);
+
+    size_t warmAllocations = resource.allocations;
+    heapAllocations = 0;
+    countHeapAllocations = true;
+    for (int round = 0; round < 10; ++round) {
+        std::copy(arr.begin(), arr.end(), work.begin());
+        mergeSort3To8(work.data(), work.size(), scratch);
+        std::copy(arr.begin(), arr.end(), work.begin());
+        mergeSortVarSort5(work.data(), work.size(), scratch);
+        std::copy(arr.begin(), arr.end(), work.begin());
+        mergeSortNatural3To8(work.data(), work.size(), scratch);
+    }
+    countHeapAllocations = false;
+
+    ASSERT_TRUE(isSorted(work));
+    ASSERT_EQ(resource.allocations, warmAllocations);
+    ASSERT_EQ(heapAllocations, 0u);
+}
+
+TEST(MergeSortCorrectnessTest, CacheAware) {
+    for (int size : {10, 100, 1000, 10000}) {
+        SCOPED_TRACE("Cache-aware Merge Sort, size=" + std::to_string(size));
+        testSortCorrectness(mergeSort3To8CacheAware, size);
+    }
+}
+
+TEST(MergeSortCorrectnessTest, TiledMultiwayPasses) {
+    SortScratch scratch;
+    // Small tiles force one, two and three multiway passes, with ragged
+    // final tiles and groups.
+    for (int size : {1000, 10007, 100003}) {
+        for (int ways : {2, 5, 64}) {
+            SCOPED_TRACE("Tiled Merge Sort, size=" + std::to_string(size) + ", ways=" + std::to_string(ways));
+            std::vector<int> arr(size);
+            for (int& value : arr) {
+                value = rand() % 1000;
+            }
+            std::vector<int> expected = arr;
+            std::sort(expected.begin(), expected.end());
+            mergeSort3To8Tiled(arr.data(), arr.size(), 97, ways, scratch);
+            ASSERT_EQ(arr, expected);
+        }
+    }
+}
+
+TEST(MergeSortCorrectnessTest, DetectedCacheSizes) {
+    const CacheSizes& caches = detectCacheSizes();
+    ASSERT_GT(caches.l1d, 0u);
+    ASSERT_LE(caches.l1d, caches.l2);
+    ASSERT_LE(caches.l2, caches.l3);
+}
+
+TEST(MergeSortCorrectnessTest, Prefetch) {
+    // Sizes above kPrefetchMinElements take the prefetching loops.
+    for (int distance : {0, 64, 1024}) {
+        for (int size : {10, 1000, 200000}) {
+            SCOPED_TRACE("Prefetching Merge Sort, size=" + std::to_string(size) + ", distance=" + std::to_string(distance));
+            std::vector<int> arr(size);
+            for (int& value : arr) {
+                value = rand() % 100000;
+            }
+            mergeSort3To8Prefetch(arr.data(), arr.size(), distance);
+            ASSERT_TRUE(isSorted(arr));
+        }
+    }
+}
+
+TEST(MergeSortCorrectnessTest, Streaming) {
+    SortScratch scratch;
+    // A zero threshold streams every merge, covering misaligned heads and
+    // short tails at all levels.
+    for (size_t threshold : {size_t(0), size_t(4096), size_t(1) << 40}) {
+        for (int size : {1, 5, 17, 1000, 100003}) {
+            SCOPED_TRACE("Streaming Merge Sort, size=" + std::to_string(size) + ", threshold=" + std::to_string(threshold));
+            std::vector<int> arr(size);
+            for (int& value : arr) {
+                value = rand() % 1000;
+            }
+            std::vector<int> expected = arr;
+            std::sort(expected.begin(), expected.end());
+            mergeSort3To8Streaming(arr.data(), arr.size(), threshold, scratch);
+            ASSERT_EQ(arr, expected);
+        }
+    }
+    for (int size : {10, 1000}) {
+        testSortCorrectness(mergeSort3To8Streaming, size);
+    }
+}
+
+TEST(MergeSortCorrectnessTest, Natural) {
+    for (int size : {10, 100, 1000, 10000}) {
+        SCOPED_TRACE("Natural Merge Sort, size=" + std::to_string(size));
+        testSortCorrectness(mergeSortNatural3To8, size);
+    }
+    // Ascending, descending (with and without ties) and interleaved runs of
+    // assorted lengths.
+    SortScratch scratch;
+    for (int runLength : {1, 7, 31, 32, 33, 500}) {
+        for (int size : {1, 2, 63, 1000, 100003}) {
+            SCOPED_TRACE("runLength=" + std::to_string(runLength) + ", size=" + std::to_string(size));
+            std::vector<int> arr(size);
+            for (int i = 0; i < size; ++i) {
+                int run = i / runLength;
+                int offset = i % runLength;
+                arr[i] = run % 3 == 0 ? offset : run % 3 == 1 ? runLength - offset : (offset / 2) * -1;
+            }
+            std::vector<int> expected = arr;
+            std::sort(expected.begin(), expected.end());
+            mergeSortNatural3To8(arr.data(), arr.size(), scratch);
+            ASSERT_EQ(arr, expected);
+        }
+    }
+}
+
+TEST(MergeSortCorrectnessTest, InPlace) {
+    std::vector<std::pair<const char*, void (*)(int*, int)>> variants = {
+        {"Classic", mergeSortInPlaceClassic}, {"3To8", mergeSortInPlace3To8},
+        {"3", mergeSortInPlace3}, {"3To4", mergeSortInPlace3To4},
+        {"3To5", mergeSortInPlace3To5}, {"Even", mergeSortInPlaceEven},
+        {"Odd", mergeSortInPlaceOdd}, {"PowerOf2", mergeSortInPlacePowerOf2},
+        {"VarSort3", mergeSortInPlaceVarSort3}, {"VarSort4", mergeSortInPlaceVarSort4},
+        {"VarSort5", mergeSortInPlaceVarSort5},
+    };
+    for (const auto& variant : variants) {
+        for (int size : {10, 100, 1000, 10000, 100003}) {
+            SCOPED_TRACE(std::string("In-Place Merge Sort ") + variant.first + ", size=" + std::to_string(size));
+            testSortCorrectness(variant.second, size);
+        }
+    }
+}
+
+TEST(MergeSortCorrectnessTest, InPlaceMergeUnevenRuns) {
+    // Run lengths on both sides of the stack cache, including very lopsided
+    // splits that exercise both rotation directions.
+    for (int n1 : {1, 255, 256, 257, 3000, 40000}) {
+        for (int n2 : {1, 256, 257, 5000, 40000}) {
+            SCOPED_TRACE("n1=" + std::to_string(n1) + ", n2=" + std::to_string(n2));
+            std::vector<int> arr(n1 + n2);
+            for (int& value : arr) {
+                value = rand() % 100;
+            }
+            std::sort(arr.begin(), arr.begin() + n1);
+            std::sort(arr.begin() + n1, arr.end());
+            std::vector<int> expected = arr;
+            std::inplace_merge(expected.begin(), expected.begin() + n1, expected.end());
+            mergeInPlace(arr.data(), 0, n1 - 1, n1 + n2 - 1);
+            ASSERT_EQ(arr, expected);
+        }
+    }
+}
+
+TEST(MergeSortCorrectnessTest, InPlaceDoesNotAllocate) {
+    std::vector<int> arr(100000);
+    for (int& value : arr) {
+        value = rand();
+    }
+    heapAllocations = 0;
+    countHeapAllocations = true;
+    mergeSortInPlace3To8(arr.data(), arr.size());
+    countHeapAllocations = false;
+
+    ASSERT_TRUE(isSorted(arr));
+    ASSERT_EQ(heapAllocations, 0u);
+}
+
+TEST(MergeSortCorrectnessTest, Unique) {
+    std::vector<std::pair<const char*, int (*)(int*, int)>> variants = {
+        {"Classic", mergeSortUniqueClassic}, {"3To8", mergeSortUnique3To8},
+        {"3", mergeSortUnique3}, {"3To4", mergeSortUnique3To4},
+        {"3To5", mergeSortUnique3To5}, {"Even", mergeSortUniqueEven},
+        {"Odd", mergeSortUniqueOdd}, {"PowerOf2", mergeSortUniquePowerOf2},
+        {"VarSort3", mergeSortUniqueVarSort3}, {"VarSort4", mergeSortUniqueVarSort4},
+        {"VarSort5", mergeSortUniqueVarSort5},
+    };
+    for (const auto& variant : variants) {
+        for (int size : {0, 1, 2, 10, 1000, 10000}) {
+            for (int range : {1, 7, 1000, 1000000}) {
+                SCOPED_TRACE(std::string("Unique Merge Sort ") + variant.first + ", size=" + std::to_string(size) +
+                             ", range=" + std::to_string(range));
+                std::vector<int> arr(size);
+                for (int& value : arr) {
+                    value = rand() % range;
+                }
+                std::vector<int> expected = arr;
+                std::sort(expected.begin(), expected.end());
+                expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+
+                int length = variant.second(arr.data(), size);
+                arr.resize(length);
+                ASSERT_EQ(arr, expected);
+            }
+        }
+    }
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -1,4 +1,6 @@
 #include "../algorithms/quick_sort_variants.h"
+#include <string>
+#include <thread>
 #include <vector>
 #include <algorithm>
 #include "gtest/gtest.h"
@@ -102,6 +104,179 @@ TEST(QuickSortCorrectnessTest, VarSort5) {
     }
 }
 
+TEST(QuickSortCorrectnessTest, MedianOf5Pivot) {
+    for (int size : {10, 100, 1000, 10000}) {
+        SCOPED_TRACE("Median-of-5 Quick Sort, size=" + std::to_string(size));
+        testSortCorrectness(quickSort3To8MedianOf5, size);
+    }
+}
+
+TEST(QuickSortCorrectnessTest, NintherPivot) {
+    for (int size : {10, 100, 1000, 10000}) {
+        SCOPED_TRACE("Ninther Quick Sort, size=" + std::to_string(size));
+        testSortCorrectness(quickSort3To8Ninther, size);
+    }
+}
+
+TEST(QuickSortCorrectnessTest, PseudoMedianOf25Pivot) {
+    for (int size : {10, 100, 1000, 10000}) {
+        SCOPED_TRACE("Pseudomedian-of-25 Quick Sort, size=" + std::to_string(size));
+        testSortCorrectness(quickSort3To8PseudoMedianOf25, size);
+    }
+}
+
+TEST(QuickSortCorrectnessTest, ThreeWay) {
+    for (int size : {10, 100, 1000, 10000}) {
+        SCOPED_TRACE("Three-Way Quick Sort, size=" + std::to_string(size));
+        testSortCorrectness(quickSort3To8ThreeWay, size);
+    }
+    for (int distinct : {1, 2, 5, 1000000}) {
+        std::vector<int> arr(100000);
+        for (int& value : arr) {
+            value = rand() % distinct - distinct / 2;
+        }
+        std::vector<int> expected = arr;
+        std::sort(expected.begin(), expected.end());
+        quickSort3To8ThreeWay(arr.data(), arr.size());
+        ASSERT_EQ(arr, expected) << "distinct=" << distinct;
+    }
+}
+
+TEST(QuickSortCorrectnessTest, MaxDepth) {
+    for (PivotSelection pivot : {PivotSelection::MedianOfThree, PivotSelection::MedianOf5,
+                                 PivotSelection::Ninther, PivotSelection::PseudoMedianOf25}) {
+        std::vector<int> arr(10000);
+        for (int& value : arr) {
+            value = rand() % 1000;
+        }
+        int depth = quickSort3To8MaxDepth(arr.data(), arr.size(), pivot);
+        ASSERT_TRUE(isSorted(arr));
+        ASSERT_GT(depth, 0);
+        ASSERT_LT(depth, 100);
+    }
+}
+
+TEST(QuickSortCorrectnessTest, PivotAndPartitionPolicies) {
+    const PivotSelection pivots[] = {PivotSelection::MedianOfThree, PivotSelection::MedianOf5,
+                                     PivotSelection::Ninther, PivotSelection::PseudoMedianOf25,
+                                     PivotSelection::Random, PivotSelection::Last};
+    const PartitionScheme partitions[] = {PartitionScheme::Hoare, PartitionScheme::BranchlessLomuto,
+                                          PartitionScheme::ThreeWay};
+    for (PivotSelection pivot : pivots) {
+        for (PartitionScheme partition : partitions) {
+            // Random values, heavy duplicates, all equal, sorted and
+            // descending runs.
+            for (int shape = 0; shape < 5; ++shape) {
+                SCOPED_TRACE("pivot=" + std::to_string(static_cast<int>(pivot)) + ", partition=" +
+                             std::to_string(static_cast<int>(partition)) + ", shape=" + std::to_string(shape));
+                std::vector<int> arr(5000);
+                for (int i = 0; i < 5000; ++i) {
+                    arr[i] = shape == 0 ? rand() : shape == 1 ? rand() % 4 : shape == 2 ? 7 : shape == 3 ? i : -i;
+                }
+                std::vector<int> expected = arr;
+                std::sort(expected.begin(), expected.end());
+                quickSort3To8With(arr.data(), arr.size(), pivot, partition);
+                ASSERT_EQ(arr, expected);
+            }
+        }
+    }
+}
+
+TEST(QuickSortCorrectnessTest, RandomPivotAcrossThreads) {
+    std::vector<std::vector<int>> arrays(4, std::vector<int>(50000));
+    for (std::vector<int>& arr : arrays) {
+        for (int& value : arr) {
+            value = rand();
+        }
+    }
+    std::vector<std::thread> threads;
+    for (std::vector<int>& arr : arrays) {
+        threads.emplace_back([&arr] {
+            quickSort3To8With(arr.data(), arr.size(), PivotSelection::Random, PartitionScheme::BranchlessLomuto);
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    for (const std::vector<int>& arr : arrays) {
+        ASSERT_TRUE(isSorted(arr));
+    }
+}
+
+TEST(QuickSortCorrectnessTest, Prefetch) {
+    // Sizes above kPrefetchMinElements take the prefetching loops.
+    for (int distance : {0, 64, 1024}) {
+        for (int size : {10, 1000, 200000}) {
+            SCOPED_TRACE("Prefetching Quick Sort, size=" + std::to_string(size) + ", distance=" + std::to_string(distance));
+            std::vector<int> arr(size);
+            for (int& value : arr) {
+                value = rand() % 100000;
+            }
+            quickSort3To8Prefetch(arr.data(), arr.size(), distance);
+            ASSERT_TRUE(isSorted(arr));
+        }
+    }
+}
+
+static std::vector<int> randomArray(int size, int range) {
+    std::vector<int> arr(size);
+    for (int& value : arr) {
+        value = rand() % range;
+    }
+    return arr;
+}
+
+TEST(QuickSortCorrectnessTest, NthElement) {
+    for (int size : {1, 2, 9, 100, 10000}) {
+        for (int range : {3, 1000000}) {
+            std::vector<int> original = randomArray(size, range);
+            std::vector<int> expected = original;
+            std::sort(expected.begin(), expected.end());
+            for (int n : {0, size / 3, size / 2, size - 1}) {
+                SCOPED_TRACE("size=" + std::to_string(size) + ", range=" + std::to_string(range) + ", n=" + std::to_string(n));
+                std::vector<int> arr = original;
+                nthElement(arr.data(), size, n);
+                ASSERT_EQ(arr[n], expected[n]);
+                for (int i = 0; i < n; ++i) ASSERT_LE(arr[i], arr[n]);
+                for (int i = n + 1; i < size; ++i) ASSERT_GE(arr[i], arr[n]);
+            }
+        }
+    }
+}
+
+TEST(QuickSortCorrectnessTest, PartialSort) {
+    for (int size : {1, 2, 9, 100, 10000}) {
+        std::vector<int> original = randomArray(size, 1000);
+        std::vector<int> expected = original;
+        std::sort(expected.begin(), expected.end());
+        for (int k : {1, 2, 10, size / 2, size, size + 5}) {
+            SCOPED_TRACE("size=" + std::to_string(size) + ", k=" + std::to_string(k));
+            std::vector<int> arr = original;
+            partialSort(arr.data(), size, k);
+            int sortedPrefix = std::min(k, size);
+            ASSERT_TRUE(std::equal(arr.begin(), arr.begin() + sortedPrefix, expected.begin()));
+            std::sort(arr.begin(), arr.end());
+            ASSERT_EQ(arr, expected);
+        }
+    }
+}
+
+TEST(QuickSortCorrectnessTest, TopK) {
+    for (int size : {1, 2, 9, 100, 10000}) {
+        std::vector<int> original = randomArray(size, 1000);
+        std::vector<int> expected = original;
+        std::sort(expected.begin(), expected.end());
+        for (int k : {0, 1, 10, size / 2, size}) {
+            if (k > size) continue;
+            SCOPED_TRACE("size=" + std::to_string(size) + ", k=" + std::to_string(k));
+            std::vector<int> arr = original;
+            topK(arr.data(), size, k);
+            std::sort(arr.begin(), arr.begin() + k);
+            ASSERT_TRUE(std::equal(arr.begin(), arr.begin() + k, expected.begin()));
+        }
+    }
+}
+
 TEST(QuickSortCorrectnessTest, EdgeCases) {
     std::vector<int> empty;
     quickSortClassic(empty.data(), empty.size());
@@ -0,0 +1,57 @@
+#include "../algorithms/segmented_sort.h"
+#include <vector>
+#include <algorithm>
+#include <string>
+#include "gtest/gtest.h"
+
+// Segment lengths mix empty, tiny, medium and a few segments larger than L2.
+static std::vector<int> randomOffsets(int segmentCount) {
+    std::vector<int> offsets = {0};
+    for (int s = 0; s < segmentCount; ++s) {
+        int kind = rand() % 100;
+        int size = kind < 60 ? rand() % 9 : kind < 98 ? rand() % 2000 : 100000 + rand() % 300000;
+        offsets.push_back(offsets.back() + size);
+    }
+    return offsets;
+}
+
+TEST(SegmentedSortTest, MatchesPerSegmentSort) {
+    for (int threads : {1, 2, 4}) {
+        for (int segmentCount : {0, 1, 10, 500}) {
+            SCOPED_TRACE("threads=" + std::to_string(threads) + ", segments=" + std::to_string(segmentCount));
+            std::vector<int> offsets = randomOffsets(segmentCount);
+            std::vector<int> data(offsets.back());
+            for (int& value : data) {
+                value = rand() % 1000;
+            }
+            std::vector<int> expected = data;
+            for (int s = 0; s < segmentCount; ++s) {
+                std::sort(expected.begin() + offsets[s], expected.begin() + offsets[s + 1]);
+            }
+
+            segmentedSort(data.data(), offsets.data(), segmentCount, threads);
+            ASSERT_EQ(data, expected);
+        }
+    }
+}
+
+TEST(SegmentedSortTest, SegmentsStayIndependent) {
+    // Descending values across the whole buffer: sorting must not move
+    // anything across a segment boundary.
+    std::vector<int> offsets = {0, 3, 3, 11, 12, 40};
+    std::vector<int> data(offsets.back());
+    for (int i = 0; i < static_cast<int>(data.size()); ++i) {
+        data[i] = -i;
+    }
+    segmentedSort(data.data(), offsets.data(), offsets.size() - 1, 3);
+    for (size_t s = 0; s + 1 < offsets.size(); ++s) {
+        for (int i = offsets[s]; i < offsets[s + 1]; ++i) {
+            ASSERT_EQ(data[i], -(offsets[s] + offsets[s + 1] - 1 - i));
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,66 @@
+#include "../algorithms/merge_sort_variants.h"
+#include "../algorithms/quick_sort_variants.h"
+#include "../algorithms/sort_stats.h"
+#include <vector>
+#include <algorithm>
+#include "gtest/gtest.h"
+
+std::vector<int> randomArray(int size) {
+    std::vector<int> arr(size);
+    for (int i = 0; i < size; ++i) {
+        arr[i] = rand() % 1000;
+    }
+    return arr;
+}
+
+TEST(SortStatsTest, Enabled) {
+    ASSERT_TRUE(sort_stats::kEnabled) << "sort_stats_test must be built with -DSORT_STATS";
+}
+
+TEST(SortStatsTest, MergeSortCountsLeavesAndMoves) {
+    auto arr = randomArray(1000);
+    sort_stats::reset();
+    mergeSort3To8(arr.data(), arr.size());
+    SortStats stats = sort_stats::snapshot();
+
+    ASSERT_TRUE(std::is_sorted(arr.begin(), arr.end()));
+    uint64_t leafElements = 0;
+    for (int size = 0; size <= kMaxNetworkLeafSize; ++size) {
+        leafElements += size * stats.networkLeaves[size];
+    }
+    ASSERT_EQ(leafElements, 1000u);
+    ASSERT_GT(stats.comparisons, 0u);
+    ASSERT_GT(stats.mergeElementsMoved, 1000u);
+    ASSERT_EQ(stats.maxRecursionDepth, 7);
+}
+
+TEST(SortStatsTest, QuickSortRecordsPartitions) {
+    auto arr = randomArray(10000);
+    sort_stats::reset();
+    int depth = quickSort3To8MaxDepth(arr.data(), arr.size(), PivotSelection::MedianOfThree);
+    SortStats stats = sort_stats::snapshot();
+
+    ASSERT_TRUE(std::is_sorted(arr.begin(), arr.end()));
+    ASSERT_EQ(stats.maxRecursionDepth, depth);
+    ASSERT_GT(stats.swaps, 0u);
+    uint64_t partitions = 0;
+    for (uint64_t count : stats.partitionBalance) {
+        partitions += count;
+    }
+    ASSERT_GT(partitions, 0u);
+    ASSERT_EQ(stats.mergeElementsMoved, 0u);
+}
+
+TEST(SortStatsTest, Reset) {
+    auto arr = randomArray(100);
+    quickSort3To8(arr.data(), arr.size());
+    sort_stats::reset();
+    SortStats stats = sort_stats::snapshot();
+    ASSERT_EQ(stats.comparisons, 0u);
+    ASSERT_EQ(stats.maxRecursionDepth, 0);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,64 @@
+#include "../algorithms/sorted_accumulator.h"
+#include <vector>
+#include <algorithm>
+#include <string>
+#include "gtest/gtest.h"
+
+TEST(SortedAccumulatorTest, MatchesFullSortAfterEachBatch) {
+    SortedAccumulator accumulator;
+    std::vector<int> all;
+    for (int batch = 0; batch < 200; ++batch) {
+        int count = 1 + rand() % 50;
+        std::vector<int> values(count);
+        for (int& value : values) {
+            value = rand() % 1000;
+        }
+        accumulator.append(values.data(), count);
+        all.insert(all.end(), values.begin(), values.end());
+
+        if (batch % 17 == 0) {
+            SCOPED_TRACE("batch=" + std::to_string(batch));
+            std::vector<int> expected = all;
+            std::sort(expected.begin(), expected.end());
+            ASSERT_EQ(accumulator.sorted(), expected);
+            ASSERT_EQ(accumulator.levelCount(), 1);
+        }
+    }
+    std::sort(all.begin(), all.end());
+    ASSERT_EQ(accumulator.sorted(), all);
+    ASSERT_EQ(accumulator.size(), static_cast<int>(all.size()));
+}
+
+TEST(SortedAccumulatorTest, LevelCountStaysLogarithmic) {
+    SortedAccumulator accumulator;
+    std::vector<int> batch(8);
+    for (int round = 0; round < 4096; ++round) {
+        for (int& value : batch) {
+            value = rand();
+        }
+        accumulator.append(batch.data(), batch.size());
+        // Each level is more than twice the next, so sizes grow geometrically.
+        ASSERT_LE(accumulator.levelCount(), 16);
+    }
+}
+
+TEST(SortedAccumulatorTest, EmptyBatchesAndClear) {
+    SortedAccumulator accumulator;
+    accumulator.append(nullptr, 0);
+    ASSERT_EQ(accumulator.size(), 0);
+    ASSERT_TRUE(accumulator.sorted().empty());
+
+    std::vector<int> values = {3, 1, 2};
+    accumulator.append(values.data(), values.size());
+    accumulator.clear();
+    ASSERT_EQ(accumulator.size(), 0);
+    ASSERT_EQ(accumulator.levelCount(), 0);
+
+    accumulator.append(values.data(), values.size());
+    ASSERT_EQ(accumulator.sorted(), std::vector<int>({1, 2, 3}));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
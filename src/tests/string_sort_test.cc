@@ -0,0 +1,92 @@
+#include "../algorithms/string_sort.h"
+#include <vector>
+#include <algorithm>
+#include <string>
+#include "gtest/gtest.h"
+
+static std::string randomString(int maxLength, const std::string& alphabet) {
+    int length = rand() % (maxLength + 1);
+    std::string str;
+    for (int i = 0; i < length; ++i) {
+        str += alphabet[rand() % alphabet.size()];
+    }
+    return str;
+}
+
+static void expectSortsLikeStd(std::vector<std::string> strings, int prefixBytes) {
+    std::vector<std::string> expected = strings;
+    std::sort(expected.begin(), expected.end(), [](const std::string& a, const std::string& b) {
+        return std::string_view(a) < std::string_view(b);
+    });
+    sortStrings(strings.data(), strings.size(), prefixBytes);
+    ASSERT_EQ(strings, expected);
+}
+
+TEST(StringSortTest, RandomStrings) {
+    for (int prefixBytes : {4, 8}) {
+        for (int size : {0, 1, 2, 10, 1000, 20000}) {
+            SCOPED_TRACE("prefixBytes=" + std::to_string(prefixBytes) + ", size=" + std::to_string(size));
+            std::vector<std::string> strings(size);
+            for (std::string& str : strings) {
+                str = randomString(20, "abcdefghijklmnopqrstuvwxyz");
+            }
+            expectSortsLikeStd(strings, prefixBytes);
+        }
+    }
+}
+
+TEST(StringSortTest, SharedPrefixesAndDuplicates) {
+    // Long common prefixes force several rounds of tie resolution; a tiny
+    // alphabet produces many duplicates and strings that are prefixes of
+    // others.
+    for (int prefixBytes : {4, 8}) {
+        std::vector<std::string> strings(5000);
+        for (std::string& str : strings) {
+            str = "/usr/local/share/" + randomString(12, "ab");
+        }
+        expectSortsLikeStd(strings, prefixBytes);
+    }
+}
+
+TEST(StringSortTest, VeryLongSharedPrefixes) {
+    // Each tied prefix word is one more round; this used to be one more
+    // level of recursion and overflowed the stack.
+    const std::string prefix(600 * 1024, 'x');
+    for (int prefixBytes : {4, 8}) {
+        SCOPED_TRACE("prefixBytes=" + std::to_string(prefixBytes));
+        std::vector<std::string> strings = {prefix + "b", prefix, prefix + "a", prefix + "b", prefix + "ab"};
+        expectSortsLikeStd(strings, prefixBytes);
+    }
+}
+
+TEST(StringSortTest, ZeroAndHighBytes) {
+    // Embedded zeros must not be confused with the padding past the end, and
+    // bytes >= 0x80 must sort after ASCII.
+    std::string alphabet = std::string("\0a\x7f\x80\xff", 5);
+    for (int prefixBytes : {4, 8}) {
+        std::vector<std::string> strings(3000);
+        for (std::string& str : strings) {
+            str = randomString(11, alphabet);
+        }
+        strings.push_back("");
+        strings.push_back(std::string(9, '\0'));
+        expectSortsLikeStd(strings, prefixBytes);
+    }
+}
+
+TEST(StringSortTest, StringViews) {
+    std::vector<std::string> storage(1000);
+    for (std::string& str : storage) {
+        str = randomString(16, "xyz");
+    }
+    std::vector<std::string_view> views(storage.begin(), storage.end());
+    std::vector<std::string_view> expected = views;
+    std::sort(expected.begin(), expected.end());
+    sortStringViews(views.data(), views.size());
+    ASSERT_EQ(views, expected);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,179 @@
+// Sorts a file of native-endian int32 records in place through a shared
+// read-write mapping, so the data is never copied into a heap buffer.
+//
+//   mmap_sort [--variant=quickSort3To8] [--advice=auto|normal|sequential|random|none]
+//             [--no-sync] [--check] file
+//
+// The quick sort and in-place merge sort variants need no memory beyond the
+// mapping; the other merge sorts allocate a scratch buffer of half the file.
+// With --advice=auto the file is read ahead with MADV_SEQUENTIAL and
+// MADV_WILLNEED before sorting and the mapping is switched to MADV_NORMAL for
+// the sort itself, whose recursion revisits pages that sequential advice
+// would let the kernel drop. Page faults are taken from getrusage() around
+// each phase.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "sort_variants.h"
+
+struct PhaseStats {
+    double seconds;
+    long minorFaults;
+    long majorFaults;
+};
+
+class PhaseTimer {
+public:
+    PhaseTimer() {
+        getrusage(RUSAGE_SELF, &usage_);
+        start_ = std::chrono::steady_clock::now();
+    }
+
+    PhaseStats stop() const {
+        auto end = std::chrono::steady_clock::now();
+        rusage now;
+        getrusage(RUSAGE_SELF, &now);
+        return {std::chrono::duration<double>(end - start_).count(),
+                now.ru_minflt - usage_.ru_minflt, now.ru_majflt - usage_.ru_majflt};
+    }
+
+private:
+    rusage usage_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+static void report(const char* phase, const PhaseStats& stats, size_t bytes) {
+    std::printf("%-8s %10.3f ms %10.1f MB/s %10ld minor faults %8ld major faults\n", phase,
+                stats.seconds * 1e3, bytes / 1e6 / std::max(stats.seconds, 1e-9),
+                stats.minorFaults, stats.majorFaults);
+}
+
+static void advise(void* addr, size_t bytes, int advice, const char* name) {
+    if (madvise(addr, bytes, advice) != 0) {
+        std::fprintf(stderr, "warning: madvise(%s): %s\n", name, std::strerror(errno));
+    }
+}
+
+static int usage(const char* argv0) {
+    std::fprintf(stderr, "usage: %s [--variant=quickSort3To8] [--advice=auto|normal|sequential|random|none] "
+                         "[--no-sync] [--check] file\n", argv0);
+    printVariants(stderr);
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    std::string variantName = "quickSort3To8";
+    std::string advice = "auto";
+    bool sync = true;
+    bool check = false;
+    std::string path;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.compare(0, 10, "--variant=") == 0) {
+            variantName = arg.substr(10);
+        } else if (arg.compare(0, 9, "--advice=") == 0) {
+            advice = arg.substr(9);
+        } else if (arg == "--no-sync") {
+            sync = false;
+        } else if (arg == "--check") {
+            check = true;
+        } else if (path.empty() && arg.compare(0, 2, "--") != 0) {
+            path = arg;
+        } else {
+            return usage(argv[0]);
+        }
+    }
+
+    const Variant* variant = findVariant(variantName);
+    int sortAdvice = MADV_NORMAL;
+    if (advice == "sequential") {
+        sortAdvice = MADV_SEQUENTIAL;
+    } else if (advice == "random") {
+        sortAdvice = MADV_RANDOM;
+    } else if (advice != "auto" && advice != "normal" && advice != "none") {
+        return usage(argv[0]);
+    }
+    if (path.empty() || variant == nullptr) return usage(argv[0]);
+
+    int fd = open(path.c_str(), O_RDWR);
+    if (fd < 0) {
+        std::fprintf(stderr, "could not open %s: %s\n", path.c_str(), std::strerror(errno));
+        return 1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        std::fprintf(stderr, "could not stat %s: %s\n", path.c_str(), std::strerror(errno));
+        close(fd);
+        return 1;
+    }
+    const size_t bytes = st.st_size;
+    if (bytes % sizeof(int) != 0 || bytes / sizeof(int) > static_cast<size_t>(INT_MAX)) {
+        std::fprintf(stderr, "%s: size %zu is not a whole number of int32 records below 2^31\n",
+                     path.c_str(), bytes);
+        close(fd);
+        return 1;
+    }
+    const int size = bytes / sizeof(int);
+    if (size == 0) {
+        close(fd);
+        return 0;
+    }
+
+    void* mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        std::fprintf(stderr, "could not map %s: %s\n", path.c_str(), std::strerror(errno));
+        return 1;
+    }
+    int* data = static_cast<int*>(mapping);
+
+    std::printf("%s: %d records, %.1f MB, %s\n", path.c_str(), size, bytes / 1e6, variant->name);
+    if (advice == "auto") {
+        PhaseTimer timer;
+        advise(mapping, bytes, MADV_SEQUENTIAL, "MADV_SEQUENTIAL");
+        advise(mapping, bytes, MADV_WILLNEED, "MADV_WILLNEED");
+        // Touch one int per page so the read-ahead is complete before timing
+        // the sort.
+        const size_t pageInts = sysconf(_SC_PAGESIZE) / sizeof(int);
+        volatile int sink = 0;
+        for (size_t i = 0; i < static_cast<size_t>(size); i += pageInts) {
+            sink = sink + data[i];
+        }
+        report("load", timer.stop(), bytes);
+    }
+    if (advice != "none") {
+        advise(mapping, bytes, sortAdvice, "sort advice");
+    }
+
+    PhaseTimer sortTimer;
+    variant->sort(data, size);
+    report("sort", sortTimer.stop(), bytes);
+
+    if (sync) {
+        PhaseTimer syncTimer;
+        if (msync(mapping, bytes, MS_SYNC) != 0) {
+            std::fprintf(stderr, "msync failed: %s\n", std::strerror(errno));
+            munmap(mapping, bytes);
+            return 1;
+        }
+        report("sync", syncTimer.stop(), bytes);
+    }
+
+    int status = 0;
+    if (check && !std::is_sorted(data, data + size)) {
+        std::fprintf(stderr, "%s is not sorted\n", path.c_str());
+        status = 1;
+    }
+    munmap(mapping, bytes);
+    return status;
+}
@@ -0,0 +1,49 @@
+#ifndef SORT_VARIANTS_H_
+#define SORT_VARIANTS_H_
+
+#include <cstdio>
+#include <string>
+#include "../algorithms/merge_sort_variants.h"
+#include "../algorithms/quick_sort_variants.h"
+
+// Sort variants selectable by name from the command-line tools.
+struct Variant {
+    const char* name;
+    void (*sort)(int*, int);
+};
+
+static const Variant kVariants[] = {
+    {"quickSort3To8", quickSort3To8},
+    {"quickSortClassic", quickSortClassic},
+    {"quickSort3", quickSort3},
+    {"quickSort3To4", quickSort3To4},
+    {"quickSort3To5", quickSort3To5},
+    {"quickSortEven", quickSortEven},
+    {"quickSortOdd", quickSortOdd},
+    {"quickSortPowerOf2", quickSortPowerOf2},
+    {"quickSortVarSort3", quickSortVarSort3},
+    {"quickSortVarSort4", quickSortVarSort4},
+    {"quickSortVarSort5", quickSortVarSort5},
+    {"quickSort3To8Ninther", quickSort3To8Ninther},
+    {"mergeSortInPlace3To8", mergeSortInPlace3To8},
+    {"mergeSort3To8", mergeSort3To8},
+    {"mergeSort3To8CacheAware", mergeSort3To8CacheAware},
+    {"mergeSortClassic", mergeSortClassic},
+};
+
+static inline const Variant* findVariant(const std::string& name) {
+    for (const Variant& variant : kVariants) {
+        if (name == variant.name) return &variant;
+    }
+    return nullptr;
+}
+
+static inline void printVariants(FILE* stream) {
+    std::fprintf(stream, "variants:");
+    for (const Variant& variant : kVariants) {
+        std::fprintf(stream, " %s", variant.name);
+    }
+    std::fprintf(stream, "\n");
+}
+
+#endif
@@ -0,0 +1,146 @@
+// Sorts newline-delimited decimal int32 values from stdin to stdout.
+//
+//   text_sort [--variant=quickSort3To8] [--quiet] < input.txt > sorted.txt
+//
+// Input is read in large blocks with read(2) and parsed with
+// parseIntegerLines; output is formatted with formatIntegerLines into a
+// buffer flushed with write(2). The time spent in each stage (read, parse,
+// sort, format, write) is reported on stderr unless --quiet is given.
+
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "../algorithms/int_text.h"
+#include "sort_variants.h"
+
+static const size_t kReadBlockBytes = 1 << 22;
+static const int kFormatBlockValues = 1 << 16;
+
+using Clock = std::chrono::steady_clock;
+
+static double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static bool writeAll(const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = write(STDOUT_FILENO, data, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += written;
+        size -= written;
+    }
+    return true;
+}
+
+static void reportParseError(const char* line, const char* end, size_t lineNumber) {
+    const char* newline = static_cast<const char*>(std::memchr(line, '\n', end - line));
+    int length = std::min<size_t>((newline ? newline : end) - line, 40);
+    std::fprintf(stderr, "line %zu: not an int32: \"%.*s\"\n", lineNumber, length, line);
+}
+
+int main(int argc, char** argv) {
+    std::string variantName = "quickSort3To8";
+    bool quiet = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.compare(0, 10, "--variant=") == 0) {
+            variantName = arg.substr(10);
+        } else if (arg == "--quiet") {
+            quiet = true;
+        } else {
+            variantName.clear();
+        }
+    }
+    const Variant* variant = findVariant(variantName);
+    if (variant == nullptr) {
+        std::fprintf(stderr, "usage: %s [--variant=quickSort3To8] [--quiet] < input > output\n", argv[0]);
+        printVariants(stderr);
+        return 2;
+    }
+
+    // Only complete lines are parsed; a partial last line is carried to the
+    // front of the buffer for the next read.
+    std::vector<char> block(kReadBlockBytes);
+    std::vector<int> values;
+    size_t carried = 0;
+    size_t linesBefore = 1;
+    double readSeconds = 0, parseSeconds = 0;
+    bool eof = false;
+    while (!eof) {
+        if (carried == block.size()) block.resize(block.size() * 2);
+        Clock::time_point start = Clock::now();
+        ssize_t got = read(STDIN_FILENO, block.data() + carried, block.size() - carried);
+        readSeconds += secondsSince(start);
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            std::fprintf(stderr, "read failed: %s\n", std::strerror(errno));
+            return 1;
+        }
+        eof = got == 0;
+
+        const char* begin = block.data();
+        const char* filled = begin + carried + got;
+        const char* end = filled;
+        if (!eof) {
+            while (end > begin && end[-1] != '\n') end--;
+        }
+        start = Clock::now();
+        const char* errorAt = nullptr;
+        bool ok = parseIntegerLines(begin, end, values, &errorAt);
+        parseSeconds += secondsSince(start);
+        if (!ok) {
+            reportParseError(errorAt, end, linesBefore + std::count(begin, errorAt, '\n'));
+            return 1;
+        }
+        if (values.size() > static_cast<size_t>(INT_MAX)) {
+            std::fprintf(stderr, "more than %d values\n", INT_MAX);
+            return 1;
+        }
+        linesBefore += std::count(begin, end, '\n');
+        carried = filled - end;
+        std::memmove(block.data(), end, carried);
+    }
+
+    const int size = values.size();
+    Clock::time_point start = Clock::now();
+    variant->sort(values.data(), size);
+    double sortSeconds = secondsSince(start);
+
+    // Formatting and writing alternate over blocks of values so the output
+    // buffer stays cache resident.
+    std::vector<char> output(static_cast<size_t>(kFormatBlockValues) * kMaxIntegerLineChars);
+    double formatSeconds = 0, writeSeconds = 0;
+    size_t outputBytes = 0;
+    for (int i = 0; i < size; i += kFormatBlockValues) {
+        start = Clock::now();
+        size_t bytes = formatIntegerLines(values.data() + i, std::min(kFormatBlockValues, size - i), output.data());
+        formatSeconds += secondsSince(start);
+        start = Clock::now();
+        if (!writeAll(output.data(), bytes)) {
+            std::fprintf(stderr, "write failed: %s\n", std::strerror(errno));
+            return 1;
+        }
+        writeSeconds += secondsSince(start);
+        outputBytes += bytes;
+    }
+
+    if (!quiet) {
+        std::fprintf(stderr, "%d values, %zu output bytes, %s\n", size, outputBytes, variant->name);
+        const char* names[] = {"read", "parse", "sort", "format", "write"};
+        double seconds[] = {readSeconds, parseSeconds, sortSeconds, formatSeconds, writeSeconds};
+        for (int s = 0; s < 5; s++) {
+            std::fprintf(stderr, "%-8s %10.3f ms %8.2f ns/value\n", names[s], seconds[s] * 1e3,
+                         seconds[s] * 1e9 / std::max(size, 1));
+        }
+    }
+    return 0;
+}